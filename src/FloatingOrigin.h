@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <span>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*
+		Convert world positions to positions relative to 'origin' in single precision.
+		The subtraction happens in double precision, so the only rounding is the final
+		narrowing and points near the origin keep full float resolution however far
+		the origin is from zero.
+
+		@param world - positions to convert.
+		@param origin - the local frame origin.
+		@param local - receives the relative positions, same size as 'world'.
+	*/
+	inline void toLocal(std::span<const Vector2<double>> world, const Vector2<double>& origin, std::span<Vector2<float>> local)
+	{
+		assert(world.size() == local.size());
+		const double* src = VectorBatch<Vector2<double>>::flat(world);
+		float*        dst = VectorBatch<Vector2<float>>::flat(local);
+		size_t n = world.size() * 2, i = 0;
+#if defined(FORCEML_SIMD_SSE2)
+		using P = Simd::PackF64;
+		using F = Simd::PackF32;
+		double pattern[P::Width];
+		for (size_t k = 0; k < P::Width; k++)
+			pattern[k] = origin[k & 1];
+		P o = P::load(pattern);
+		for (; i + F::Width <= n; i += F::Width)
+			Simd::narrow(P::load(src + i) - o, P::load(src + i + P::Width) - o).store(dst + i);
+#endif
+		for (; i < n; i++)
+			dst[i] = static_cast<float>(src[i] - origin[i & 1]);
+	}
+
+	/*
+		Convert positions relative to 'origin' back to world positions. The addition
+		happens in double precision.
+
+		@param local - relative positions to convert.
+		@param origin - the local frame origin.
+		@param world - receives the world positions, same size as 'local'.
+	*/
+	inline void toWorld(std::span<const Vector2<float>> local, const Vector2<double>& origin, std::span<Vector2<double>> world)
+	{
+		assert(world.size() == local.size());
+		const float* src = VectorBatch<Vector2<float>>::flat(local);
+		double*      dst = VectorBatch<Vector2<double>>::flat(world);
+		size_t n = local.size() * 2, i = 0;
+#if defined(FORCEML_SIMD_SSE2)
+		using P = Simd::PackF64;
+		using F = Simd::PackF32;
+		double pattern[P::Width];
+		for (size_t k = 0; k < P::Width; k++)
+			pattern[k] = origin[k & 1];
+		P o = P::load(pattern);
+		for (; i + F::Width <= n; i += F::Width)
+		{
+			P a, b;
+			Simd::widen(F::load(src + i), a, b);
+			(a + o).store(dst + i);
+			(b + o).store(dst + i + P::Width);
+		}
+#endif
+		for (; i < n; i++)
+			dst[i] = static_cast<double>(src[i]) + origin[i & 1];
+	}
+
+	/*
+		Move an array of relative positions from one origin to another in place. Each
+		element is widened, offset in double precision and narrowed again, so a shift
+		rounds once per element and never accumulates the rounding of a float offset.
+
+		@param local - positions relative to 'from'; afterwards relative to 'to'.
+		@param from, to - the old and new origin.
+	*/
+	inline void rebase(std::span<Vector2<float>> local, const Vector2<double>& from, const Vector2<double>& to)
+	{
+		Vector2<double> shift = from - to;
+		float* p = VectorBatch<Vector2<float>>::flat(local);
+		size_t n = local.size() * 2, i = 0;
+#if defined(FORCEML_SIMD_SSE2)
+		using P = Simd::PackF64;
+		using F = Simd::PackF32;
+		double pattern[P::Width];
+		for (size_t k = 0; k < P::Width; k++)
+			pattern[k] = shift[k & 1];
+		P o = P::load(pattern);
+		for (; i + F::Width <= n; i += F::Width)
+		{
+			P a, b;
+			Simd::widen(F::load(p + i), a, b);
+			Simd::narrow(a + o, b + o).store(p + i);
+		}
+#endif
+		for (; i < n; i++)
+			p[i] = static_cast<float>(static_cast<double>(p[i]) + shift[i & 1]);
+	}
+
+	/*
+		Keeps a double-precision origin near a point of interest, usually the camera,
+		so everything around it can be processed in single precision. When the focus
+		moves further than 'threshold' from the origin on either axis, the origin jumps
+		to the focus, snapped to a multiple of 'threshold' so the same area always maps
+		to the same frame.
+	*/
+	class FloatingOrigin
+	{
+	public:
+		/*
+			@param threshold - distance the focus may drift before the origin moves. Float
+			resolution at this distance is the worst the local frame ever has.
+			@param origin - initial origin.
+		*/
+		explicit FloatingOrigin(double threshold = 4096.0, const Vector2<double>& origin = Vector2<double>(0.0))
+			: threshold(threshold), origin(origin) {}
+
+		const Vector2<double>& getOrigin() const { return origin; }
+		double                 getThreshold() const { return threshold; }
+
+		bool          needsRebase(const Vector2<double>& focus) const;
+		template<typename... Arrays>
+		bool          follow(const Vector2<double>& focus, Arrays&&... arrays);
+
+		Vector2<float>  toLocal(const Vector2<double>& world) const;
+		Vector2<double> toWorld(const Vector2<float>& local) const;
+		void            toLocal(std::span<const Vector2<double>> world, std::span<Vector2<float>> local) const { Math::toLocal(world, origin, local); }
+		void            toWorld(std::span<const Vector2<float>> local, std::span<Vector2<double>> world) const { Math::toWorld(local, origin, world); }
+
+	private:
+		double          threshold;
+		Vector2<double> origin;
+	};
+
+	/*
+		Return true if 'focus' has drifted far enough from the origin to move it.
+	*/
+	inline bool FloatingOrigin::needsRebase(const Vector2<double>& focus) const
+	{
+		return std::abs(focus.x - origin.x) > threshold || std::abs(focus.y - origin.y) > threshold;
+	}
+
+	/*
+		Move the origin to 'focus' if it drifted too far, rebasing every given array of
+		relative positions to the new origin. Return true if the origin moved.
+
+		@param focus - the current point of interest, in world space.
+		@param arrays - spans (or containers convertible to spans) of Vector2<float>
+		expressed relative to the current origin.
+	*/
+	template<typename... Arrays>
+	inline bool FloatingOrigin::follow(const Vector2<double>& focus, Arrays&&... arrays)
+	{
+		if (!needsRebase(focus))
+			return false;
+		Vector2<double> next(std::round(focus.x / threshold) * threshold, std::round(focus.y / threshold) * threshold);
+		(Math::rebase(std::span<Vector2<float>>(arrays), origin, next), ...);
+		origin = next;
+		return true;
+	}
+
+	/*
+		Return a single world position relative to the origin.
+	*/
+	inline Vector2<float> FloatingOrigin::toLocal(const Vector2<double>& world) const
+	{
+		return Vector2<float>(static_cast<float>(world.x - origin.x), static_cast<float>(world.y - origin.y));
+	}
+
+	/*
+		Return the world position of a single relative position.
+	*/
+	inline Vector2<double> FloatingOrigin::toWorld(const Vector2<float>& local) const
+	{
+		return Vector2<double>(origin.x + local.x, origin.y + local.y);
+	}
+}
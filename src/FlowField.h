@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*How a flow field treats positions outside its grid.*/
+	enum class FlowFieldBoundary
+	{
+		Clamp, //Use the nearest edge cell.
+		Wrap   //Repeat the grid, for toroidal worlds.
+	};
+
+	/*
+		Grid of two-dimensional vectors sampled at arbitrary positions, e.g. steering
+		directions for crowds.
+
+		Cells are stored in 8x8 tiles, one array per component, so the four corners of
+		a bilinear lookup share a tile (and mostly a cache line) and every component of
+		a batch can be fetched with one gather per corner. Cell (i, j) holds the value
+		at the center of the cell, origin + (i + 0.5, j + 0.5) * cellSize.
+	*/
+	template<typename T>
+	class FlowField
+	{
+	public:
+		static constexpr int32_t TileShift = 3;
+		static constexpr int32_t TileSize = 1 << TileShift;
+
+		FlowField(int32_t width, int32_t height, T cellSize, const Vector2<T>& origin = Vector2<T>(), FlowFieldBoundary boundary = FlowFieldBoundary::Clamp);
+
+		int32_t           getWidth() const { return width; }
+		int32_t           getHeight() const { return height; }
+		T                 getCellSize() const { return cellSize; }
+		const Vector2<T>& getOrigin() const { return origin; }
+		FlowFieldBoundary getBoundary() const { return boundary; }
+		void              setBoundary(FlowFieldBoundary b) { boundary = b; }
+
+		Vector2<T> get(int32_t x, int32_t y) const;
+		void       set(int32_t x, int32_t y, const Vector2<T>& v);
+		void       fill(std::span<const Vector2<T>> rowMajor);
+
+		Vector2<T> sample(const Vector2<T>& p) const;
+		Vector2<T> sampleNearest(const Vector2<T>& p) const;
+		void       sample(std::span<const Vector2<T>> points, std::span<Vector2<T>> out) const;
+		void       sampleNearest(std::span<const Vector2<T>> points, std::span<Vector2<T>> out) const;
+
+	private:
+		static constexpr size_t Chunk = 64;
+
+		int32_t columnOffset(int32_t x) const { return ((x >> TileShift) << (2 * TileShift)) | (x & (TileSize - 1)); }
+		int32_t rowOffset(int32_t y) const { return (y >> TileShift) * tileRow | ((y & (TileSize - 1)) << TileShift); }
+		int32_t index(int32_t x, int32_t y) const { return rowOffset(y) + columnOffset(x); }
+
+		static T    wrap(T g, int32_t size);
+		template<bool Wrap>
+		static void axis(T g, int32_t size, int32_t& i0, int32_t& i1, T& t);
+		template<bool Wrap>
+		void        locate(const Vector2<T>* points, int32_t (*corner)[Chunk], T* tx, T* ty) const;
+		template<bool Wrap>
+		void        locateNearest(const Vector2<T>* points, int32_t* cell) const;
+
+		int32_t           width, height, tileRow;
+		T                 cellSize, inverseCell;
+		Vector2<T>        origin;
+		FlowFieldBoundary boundary;
+		std::vector<T>    xs, ys;
+	};
+
+	/*
+		Create a field of zero vectors.
+
+		@param width, height - number of cells along x and y.
+		@param cellSize - side length of a cell in world units.
+		@param origin - world position of the minimum corner of cell (0, 0).
+		@param boundary - behaviour outside the grid.
+	*/
+	template<typename T>
+	FlowField<T>::FlowField(int32_t width, int32_t height, T cellSize, const Vector2<T>& origin, FlowFieldBoundary boundary)
+		: width(width), height(height), cellSize(cellSize), inverseCell(static_cast<T>(1) / cellSize), origin(origin), boundary(boundary)
+	{
+		assert(width > 0 && height > 0 && cellSize > 0);
+		int32_t tilesX = (width + TileSize - 1) >> TileShift;
+		int32_t tilesY = (height + TileSize - 1) >> TileShift;
+		tileRow = tilesX << (2 * TileShift);
+		size_t cells = static_cast<size_t>(tileRow) * tilesY;
+		assert(cells <= static_cast<size_t>(INT32_MAX));
+		xs.assign(cells, 0);
+		ys.assign(cells, 0);
+	}
+
+	/*
+		Return the vector stored in cell (x, y).
+	*/
+	template<typename T>
+	inline Vector2<T> FlowField<T>::get(int32_t x, int32_t y) const
+	{
+		assert(x >= 0 && x < width && y >= 0 && y < height);
+		int32_t i = index(x, y);
+		return Vector2<T>(xs[i], ys[i]);
+	}
+
+	/*
+		Store v in cell (x, y).
+	*/
+	template<typename T>
+	inline void FlowField<T>::set(int32_t x, int32_t y, const Vector2<T>& v)
+	{
+		assert(x >= 0 && x < width && y >= 0 && y < height);
+		int32_t i = index(x, y);
+		xs[i] = v.x;
+		ys[i] = v.y;
+	}
+
+	/*
+		Load every cell from a row-major array of width * height vectors.
+	*/
+	template<typename T>
+	void FlowField<T>::fill(std::span<const Vector2<T>> rowMajor)
+	{
+		assert(rowMajor.size() == static_cast<size_t>(width) * height);
+		for (int32_t y = 0; y < height; y++)
+			for (int32_t x = 0; x < width; x++)
+				set(x, y, rowMajor[static_cast<size_t>(y) * width + x]);
+	}
+
+	/*
+		Reduce a grid coordinate into [0, size]. Non-finite coordinates map to 0. The
+		remainder is not trusted to land in range: far from the grid the multiply and
+		subtract round (or are contracted into one fma) and can leave it negative or
+		past 'size', so it is folded and clamped before any integer conversion.
+	*/
+	template<typename T>
+	inline T FlowField<T>::wrap(T g, int32_t size)
+	{
+		T n = static_cast<T>(size);
+		g = std::abs(g) <= std::numeric_limits<T>::max() ? g : static_cast<T>(0);
+		g -= n * std::floor(g / n);
+		g = g < 0 ? g + n : g;
+		return std::min(std::max(static_cast<T>(0), g), n);
+	}
+
+	/*
+		Map a grid coordinate (in cells, relative to the first cell center) to the two
+		cells surrounding it and the weight of the second. The clamps take the
+		coordinate as their second operand so a NaN resolves to the first cell.
+	*/
+	template<typename T>
+	template<bool Wrap>
+	inline void FlowField<T>::axis(T g, int32_t size, int32_t& i0, int32_t& i1, T& t)
+	{
+		if constexpr (Wrap)
+		{
+			g = wrap(g, size);
+			i0 = std::min(static_cast<int32_t>(g), size - 1);
+			i1 = i0 + 1 == size ? 0 : i0 + 1;
+		}
+		else
+		{
+			g = std::min(static_cast<T>(size - 1), std::max(static_cast<T>(0), g));
+			i0 = static_cast<int32_t>(g);
+			i1 = std::min(i0 + 1, size - 1);
+		}
+		t = g - static_cast<T>(i0);
+	}
+
+	/*
+		Compute the storage index of the four corners and the weights of Chunk points.
+		The trip count is fixed and the loop is free of loads from the grid, so the
+		compiler vectorizes it even at its cheapest vectorization level.
+	*/
+	template<typename T>
+	template<bool Wrap>
+	void FlowField<T>::locate(const Vector2<T>* points, int32_t (*corner)[Chunk], T* tx, T* ty) const
+	{
+		const T half = static_cast<T>(0.5);
+		for (size_t j = 0; j < Chunk; j++)
+		{
+			int32_t x0, x1, y0, y1;
+			axis<Wrap>((points[j].x - origin.x) * inverseCell - half, width, x0, x1, tx[j]);
+			axis<Wrap>((points[j].y - origin.y) * inverseCell - half, height, y0, y1, ty[j]);
+			int32_t r0 = rowOffset(y0), r1 = rowOffset(y1), c0 = columnOffset(x0), c1 = columnOffset(x1);
+			corner[0][j] = r0 + c0;
+			corner[1][j] = r0 + c1;
+			corner[2][j] = r1 + c0;
+			corner[3][j] = r1 + c1;
+		}
+	}
+
+	/*
+		Compute the storage index of the cell containing each of Chunk points.
+	*/
+	template<typename T>
+	template<bool Wrap>
+	void FlowField<T>::locateNearest(const Vector2<T>* points, int32_t* cell) const
+	{
+		for (size_t j = 0; j < Chunk; j++)
+		{
+			T gx = std::floor((points[j].x - origin.x) * inverseCell);
+			T gy = std::floor((points[j].y - origin.y) * inverseCell);
+			int32_t x, y;
+			if constexpr (Wrap)
+			{
+				x = std::min(static_cast<int32_t>(wrap(gx, width)), width - 1);
+				y = std::min(static_cast<int32_t>(wrap(gy, height)), height - 1);
+			}
+			else
+			{
+				x = static_cast<int32_t>(std::min(static_cast<T>(width - 1), std::max(static_cast<T>(0), gx)));
+				y = static_cast<int32_t>(std::min(static_cast<T>(height - 1), std::max(static_cast<T>(0), gy)));
+			}
+			cell[j] = index(x, y);
+		}
+	}
+
+	/*
+		Return the bilinear interpolation of the field at p.
+	*/
+	template<typename T>
+	Vector2<T> FlowField<T>::sample(const Vector2<T>& p) const
+	{
+		Vector2<T> r;
+		sample(std::span<const Vector2<T>>(&p, 1), std::span<Vector2<T>>(&r, 1));
+		return r;
+	}
+
+	/*
+		Return the vector of the cell containing p.
+	*/
+	template<typename T>
+	Vector2<T> FlowField<T>::sampleNearest(const Vector2<T>& p) const
+	{
+		Vector2<T> r;
+		sampleNearest(std::span<const Vector2<T>>(&p, 1), std::span<Vector2<T>>(&r, 1));
+		return r;
+	}
+
+	/*
+		Bilinearly interpolate the field at many points. Points are processed in
+		chunks: corner indices and weights are computed for the whole chunk first, then
+		each pack of lanes gathers its corners and blends them.
+
+		@param points - sample positions in world space.
+		@param out - receives the interpolated vectors, same size as 'points'.
+	*/
+	template<typename T>
+	void FlowField<T>::sample(std::span<const Vector2<T>> points, std::span<Vector2<T>> out) const
+	{
+		assert(out.size() == points.size());
+		int32_t corner[4][Chunk];
+		T tx[Chunk], ty[Chunk];
+		Vector2<T> tail[Chunk] = {};
+		const T* fx = xs.data();
+		const T* fy = ys.data();
+
+		for (size_t base = 0; base < points.size(); base += Chunk)
+		{
+			size_t m = std::min(Chunk, points.size() - base);
+			const Vector2<T>* src = points.data() + base;
+			if (m < Chunk)
+				src = std::copy_n(src, m, tail) - m;
+			if (boundary == FlowFieldBoundary::Wrap)
+				locate<true>(src, corner, tx, ty);
+			else
+				locate<false>(src, corner, tx, ty);
+
+			T* dst = out.data()[base].data();
+			auto blend = [&](auto p, size_t j)
+			{
+				using P = decltype(p);
+				P wx = P::load(tx + j), wy = P::load(ty + j);
+				P x0 = P::gather(fx, corner[0] + j), x1 = P::gather(fx, corner[1] + j);
+				P x2 = P::gather(fx, corner[2] + j), x3 = P::gather(fx, corner[3] + j);
+				P y0 = P::gather(fy, corner[0] + j), y1 = P::gather(fy, corner[1] + j);
+				P y2 = P::gather(fy, corner[2] + j), y3 = P::gather(fy, corner[3] + j);
+				P top = Simd::fma(x1 - x0, wx, x0), bottom = Simd::fma(x3 - x2, wx, x2);
+				P rx = Simd::fma(bottom - top, wy, top);
+				top = Simd::fma(y1 - y0, wx, y0);
+				bottom = Simd::fma(y3 - y2, wx, y2);
+				P ry = Simd::fma(bottom - top, wy, top);
+				P a, b;
+				Simd::interleave(rx, ry, a, b);
+				a.store(dst + 2 * j);
+				b.store(dst + 2 * j + P::Width);
+			};
+
+			using P = Simd::Pack<T>;
+			size_t j = 0;
+			for (; j + P::Width <= m; j += P::Width)
+				blend(P(), j);
+			for (; j < m; j++)
+				blend(Simd::Scalar<T>(), j);
+		}
+	}
+
+	/*
+		Look up the cell containing each of many points.
+
+		@param points - sample positions in world space.
+		@param out - receives the cell vectors, same size as 'points'.
+	*/
+	template<typename T>
+	void FlowField<T>::sampleNearest(std::span<const Vector2<T>> points, std::span<Vector2<T>> out) const
+	{
+		assert(out.size() == points.size());
+		int32_t cell[Chunk];
+		Vector2<T> tail[Chunk] = {};
+		const T* fx = xs.data();
+		const T* fy = ys.data();
+
+		for (size_t base = 0; base < points.size(); base += Chunk)
+		{
+			size_t m = std::min(Chunk, points.size() - base);
+			const Vector2<T>* src = points.data() + base;
+			if (m < Chunk)
+				src = std::copy_n(src, m, tail) - m;
+			if (boundary == FlowFieldBoundary::Wrap)
+				locateNearest<true>(src, cell);
+			else
+				locateNearest<false>(src, cell);
+
+			T* dst = out.data()[base].data();
+			auto fetch = [&](auto p, size_t j)
+			{
+				using P = decltype(p);
+				P a, b;
+				Simd::interleave(P::gather(fx, cell + j), P::gather(fy, cell + j), a, b);
+				a.store(dst + 2 * j);
+				b.store(dst + 2 * j + P::Width);
+			};
+
+			using P = Simd::Pack<T>;
+			size_t j = 0;
+			for (; j + P::Width <= m; j += P::Width)
+				fetch(P(), j);
+			for (; j < m; j++)
+				fetch(Simd::Scalar<T>(), j);
+		}
+	}
+}
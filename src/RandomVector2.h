@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*
+		Counter-based Philox4x32-10 generator (Salmon et al., "Parallel random numbers:
+		as easy as 1, 2, 3"). Each 128-bit counter is mapped to four independent 32-bit
+		words, so any position of any stream can be generated directly without stepping
+		through the preceding values.
+
+		The counter is laid out as { index.lo, index.hi, stream.lo, stream.hi } and the
+		key is the 64-bit seed. Different stream indices therefore never overlap, which
+		makes it safe to hand one stream to each thread.
+	*/
+	struct Philox4x32
+	{
+		/*Number of blocks produced by one call to generate().*/
+		static constexpr uint32_t Width = 8;
+
+		static constexpr uint32_t M0 = 0xD2511F53u;
+		static constexpr uint32_t M1 = 0xCD9E8D57u;
+		static constexpr uint32_t W0 = 0x9E3779B9u;
+		static constexpr uint32_t W1 = 0xBB67AE85u;
+
+		/*
+			Generate Width consecutive blocks starting at 'index' of 'stream'.
+			Output is stored structure-of-arrays: word k of block i is out[k][i].
+
+			The rounds run on Simd::Pack<uint32_t>, one block per lane, with the
+			32 x 32 -> 64 bit multiplies done by Simd::mulhilo.
+		*/
+		static void generate(uint64_t seed, uint64_t stream, uint64_t index, uint32_t out[4][Width])
+		{
+			using U = Simd::Pack<uint32_t>;
+			constexpr uint32_t Packs = Width / U::Width;
+			static_assert(Width % U::Width == 0, "Width must be a whole number of packs.");
+
+			//All packs advance round by round together, so their multiplies overlap
+			//instead of forming one long dependency chain each.
+			U c0[Packs], c1[Packs], c2[Packs], c3[Packs];
+			for (uint32_t p = 0; p < Packs; p++)
+			{
+				uint32_t lo[U::Width], hi[U::Width];
+				for (uint32_t i = 0; i < U::Width; i++)
+				{
+					uint64_t n = index + p * U::Width + i;
+					lo[i] = static_cast<uint32_t>(n);
+					hi[i] = static_cast<uint32_t>(n >> 32);
+				}
+				c0[p] = U::load(lo);
+				c1[p] = U::load(hi);
+				c2[p] = U::broadcast(static_cast<uint32_t>(stream));
+				c3[p] = U::broadcast(static_cast<uint32_t>(stream >> 32));
+			}
+
+			const U m0 = U::broadcast(M0), m1 = U::broadcast(M1);
+			const U w0 = U::broadcast(W0), w1 = U::broadcast(W1);
+			U k0 = U::broadcast(static_cast<uint32_t>(seed)), k1 = U::broadcast(static_cast<uint32_t>(seed >> 32));
+			for (uint32_t r = 0; r < 10; r++)
+			{
+				for (uint32_t p = 0; p < Packs; p++)
+				{
+					U h0, l0, h1, l1;
+					Simd::mulhilo(m0, c0[p], h0, l0);
+					Simd::mulhilo(m1, c2[p], h1, l1);
+					c0[p] = h1 ^ c1[p] ^ k0;
+					c2[p] = h0 ^ c3[p] ^ k1;
+					c1[p] = l1;
+					c3[p] = l0;
+				}
+				k0 = k0 + w0;
+				k1 = k1 + w1;
+			}
+
+			for (uint32_t p = 0; p < Packs; p++)
+			{
+				c0[p].store(out[0] + p * U::Width);
+				c1[p].store(out[1] + p * U::Width);
+				c2[p].store(out[2] + p * U::Width);
+				c3[p].store(out[3] + p * U::Width);
+			}
+		}
+	};
+
+	/*
+		Batch sampler that fills spans of two-dimensional vectors with random points.
+
+		Element 'i' of a call always consumes block (position + i) of the selected
+		stream, so the output does not depend on how a range is split into batches or
+		across threads: sampling [0, n) in one call or in several yields identical data.
+	*/
+	template<typename T>
+	class Vector2Sampler
+	{
+		static_assert(std::is_floating_point_v<T>, "Vector2Sampler requires a floating point component type.");
+
+	public:
+		Vector2Sampler(uint64_t seed, uint64_t stream = 0);
+
+		void     uniformBox(std::span<Vector2<T>> out, const Vector2<T>& min, const Vector2<T>& max);
+		void     uniformDisk(std::span<Vector2<T>> out, const Vector2<T>& center, T radius);
+		void     uniformCircle(std::span<Vector2<T>> out, const Vector2<T>& center, T radius);
+		void     gaussian(std::span<Vector2<T>> out, const Vector2<T>& mean, T sigma);
+
+		void     seek(uint64_t position) { this->position = position; }
+		uint64_t tell() const { return position; }
+		uint64_t getStream() const { return stream; }
+
+	private:
+		template<typename F>
+		void fill(std::span<Vector2<T>> out, F&& kernel);
+
+		//Spacing of the uniform values fill() produces: 24 bits for float, 53 for double.
+		static constexpr T Step = std::is_same_v<T, float> ? static_cast<T>(0x1p-24f) : static_cast<T>(0x1p-53);
+		static constexpr T Tau = static_cast<T>(6.283185307179586476925);
+
+		uint64_t seed;
+		uint64_t stream;
+		uint64_t position = 0;
+	};
+
+	/*
+		Create a sampler for the given seed and stream index.
+
+		@param seed - key of the generator, selects the whole family of streams.
+		@param stream - independent sub-sequence, typically the thread or job index.
+	*/
+	template<typename T>
+	inline Vector2Sampler<T>::Vector2Sampler(uint64_t seed, uint64_t stream) : seed(seed), stream(stream) {}
+
+	/*
+		Run the generator over 'out' in blocks of Philox4x32::Width, turn the words of
+		each element into two uniform values in [0, 1) on Simd packs, and let 'kernel'
+		map those x and y packs to the output in place. Each value is a multiple of
+		Step, from the top bits of one word (float) or two words (double).
+
+		A partial last block goes through the same pack code via a local buffer, so
+		every element is computed identically however the range is split.
+	*/
+	template<typename T>
+	template<typename F>
+	void Vector2Sampler<T>::fill(std::span<Vector2<T>> out, F&& kernel)
+	{
+		using P = Simd::Pack<T>;
+		using U = Simd::Pack<uint32_t>;
+		constexpr uint32_t W = Philox4x32::Width;
+		static_assert(W % P::Width == 0, "Philox4x32::Width must be a whole number of packs.");
+
+		uint32_t words[4][W];
+		Vector2<T> block[W];
+		size_t count = out.size();
+		for (size_t base = 0; base < count; base += W)
+		{
+			Philox4x32::generate(seed, stream, position + base, words);
+			//Drop the bits below Step, so the conversions below are exact.
+			for (uint32_t j = 0; j < W; j += U::Width)
+				for (uint32_t k = 0; k < 4; k++)
+				{
+					if constexpr (std::is_same_v<T, float>)
+					{
+						if (k % 2 == 0)
+							(U::load(words[k] + j) >> 8).store(words[k] + j);
+					}
+					else if (k % 2 == 1)
+						(U::load(words[k] + j) >> 11).store(words[k] + j);
+				}
+
+			size_t n = count - base < W ? count - base : W;
+			T* dst = VectorBatch<Vector2<T>>::flat(n == W ? out.subspan(base, W) : std::span<Vector2<T>>(block));
+			for (uint32_t j = 0; j < W; j += P::Width)
+			{
+				P u, v;
+				if constexpr (std::is_same_v<T, float>)
+				{
+					u = P::convert(words[0] + j) * P::broadcast(0x1p-24f);
+					v = P::convert(words[2] + j) * P::broadcast(0x1p-24f);
+				}
+				else
+				{
+					u = P::convert(words[0] + j) * P::broadcast(0x1p-32) + P::convert(words[1] + j) * P::broadcast(0x1p-53);
+					v = P::convert(words[2] + j) * P::broadcast(0x1p-32) + P::convert(words[3] + j) * P::broadcast(0x1p-53);
+				}
+				kernel(u, v);
+				P a, b;
+				Simd::interleave(u, v, a, b);
+				a.store(dst + 2 * j);
+				b.store(dst + 2 * j + P::Width);
+			}
+			if (n < W)
+				std::copy(block, block + n, out.begin() + base);
+		}
+		position += count;
+	}
+
+	/*
+		Fill 'out' with points uniformly distributed in the box [min, max).
+
+		@param out - destination span.
+		@param min, max - corners of the box.
+	*/
+	template<typename T>
+	void Vector2Sampler<T>::uniformBox(std::span<Vector2<T>> out, const Vector2<T>& min, const Vector2<T>& max)
+	{
+		T ox = min.x, oy = min.y;
+		T sx = max.x - min.x, sy = max.y - min.y;
+		fill(out, [=](auto& x, auto& y) {
+			using P = std::remove_reference_t<decltype(x)>;
+			x = P::broadcast(ox) + P::broadcast(sx) * x;
+			y = P::broadcast(oy) + P::broadcast(sy) * y;
+		});
+	}
+
+	/*
+		Fill 'out' with points uniformly distributed over the area of a disk. Uses the
+		inverse CDF r = R * sqrt(u), so there is no rejection loop and no corner bias.
+
+		@param out - destination span.
+		@param center - center of the disk.
+		@param radius - radius of the disk.
+	*/
+	template<typename T>
+	void Vector2Sampler<T>::uniformDisk(std::span<Vector2<T>> out, const Vector2<T>& center, T radius)
+	{
+		T cx = center.x, cy = center.y;
+		fill(out, [=](auto& x, auto& y) {
+			using P = std::remove_reference_t<decltype(x)>;
+			P r = P::broadcast(radius) * Simd::sqrt(x), s, c;
+			Simd::sincos(P::broadcast(Tau) * y, s, c);
+			x = P::broadcast(cx) + r * c;
+			y = P::broadcast(cy) + r * s;
+		});
+	}
+
+	/*
+		Fill 'out' with points uniformly distributed on a circle.
+
+		@param out - destination span.
+		@param center - center of the circle.
+		@param radius - radius of the circle.
+	*/
+	template<typename T>
+	void Vector2Sampler<T>::uniformCircle(std::span<Vector2<T>> out, const Vector2<T>& center, T radius)
+	{
+		T cx = center.x, cy = center.y;
+		fill(out, [=](auto& x, auto& y) {
+			using P = std::remove_reference_t<decltype(x)>;
+			P s, c;
+			Simd::sincos(P::broadcast(Tau) * x, s, c);
+			x = P::broadcast(cx) + P::broadcast(radius) * c;
+			y = P::broadcast(cy) + P::broadcast(radius) * s;
+		});
+	}
+
+	/*
+		Fill 'out' with points from an isotropic normal distribution using the
+		Box-Muller transform. Both outputs of the transform are used, one per component.
+		The radius takes the logarithm of a uniform value in (0, 1], so it is finite.
+
+		@param out - destination span.
+		@param mean - mean of the distribution.
+		@param sigma - standard deviation of each component.
+	*/
+	template<typename T>
+	void Vector2Sampler<T>::gaussian(std::span<Vector2<T>> out, const Vector2<T>& mean, T sigma)
+	{
+		T mx = mean.x, my = mean.y;
+		fill(out, [=](auto& x, auto& y) {
+			using P = std::remove_reference_t<decltype(x)>;
+			P r = P::broadcast(sigma) * Simd::sqrt(P::broadcast(T(-2)) * Simd::log(x + P::broadcast(Step))), s, c;
+			Simd::sincos(P::broadcast(Tau) * y, s, c);
+			x = P::broadcast(mx) + r * c;
+			y = P::broadcast(my) + r * s;
+		});
+	}
+}
@@ -0,0 +1,559 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "TypeAABB2.h"
+
+namespace Force::Math
+{
+	/*Represents a line segment between two points.*/
+	template<typename T>
+	struct Segment2
+	{
+		Vector2<T> a, b;
+	};
+
+	/*Represents a ray origin + t * direction, valid for t in [0, maxT].*/
+	template<typename T>
+	struct Ray2
+	{
+		Vector2<T> origin, direction;
+		T          maxT = std::numeric_limits<T>::max();
+	};
+
+	/*Result of a ray query. 'segment' is SegmentBVH::Miss when nothing was hit.*/
+	template<typename T>
+	struct SegmentHit
+	{
+		uint32_t segment;
+		T        t;
+	};
+
+	/*
+		Bounding volume hierarchy over 2D segments for ray and line-of-sight queries.
+
+		Construction uses the binned surface area heuristic (perimeter in 2D). Nodes
+		are stored depth-first in one array: the left child of an interior node
+		directly follows it and only the right child index is stored, so a node fits
+		in 24 bytes for float. Segments are copied into leaf order so every leaf is
+		one contiguous range.
+
+		Moving geometry is handled by refit(), which keeps the topology and only
+		recomputes bounds; rebuild when the motion is large enough to degrade queries.
+	*/
+	template<typename T>
+	class SegmentBVH
+	{
+	public:
+		static constexpr uint32_t Miss = std::numeric_limits<uint32_t>::max();
+		static constexpr uint32_t PacketSize = 8;
+
+		struct Node
+		{
+			T        min[2], max[2];
+			uint32_t index; // first segment of a leaf, or right child of an interior node
+			uint32_t count; // number of segments, zero for interior nodes
+		};
+
+		SegmentBVH() = default;
+		SegmentBVH(std::span<const Segment2<T>> segments);
+
+		void              build(std::span<const Segment2<T>> segments);
+		void              refit(std::span<const Segment2<T>> segments);
+
+		SegmentHit<T>     raycast(const Ray2<T>& ray) const;
+		bool              occluded(const Ray2<T>& ray) const;
+		void              raycast(std::span<const Ray2<T>> rays, std::span<SegmentHit<T>> hits) const;
+		void              occluded(std::span<const Ray2<T>> rays, std::span<bool> result) const;
+
+		std::span<const Node> getNodes() const { return nodes; }
+
+	private:
+		static constexpr uint32_t BinCount = 16;
+		static constexpr uint32_t MaxLeafSize = 8;
+		static constexpr uint32_t MaxSahDepth = 64;
+		static constexpr uint32_t StackSize = 128;
+		static constexpr T        NoEntry = std::numeric_limits<T>::infinity();
+
+		struct Build
+		{
+			AABB2<T>   bounds;
+			Vector2<T> centroid;
+			uint32_t   id;
+		};
+
+		uint32_t buildNode(std::vector<Build>& prims, uint32_t begin, uint32_t end, uint32_t depth);
+		void     setBounds(Node& node, const AABB2<T>& b);
+
+		static T    entry(const Node& node, const Vector2<T>& origin, const Vector2<T>& invDir, T maxT);
+		static T    intersect(const Segment2<T>& s, const Vector2<T>& origin, const Vector2<T>& dir);
+
+		template<bool AnyHit>
+		void traverse(const Ray2<T>& ray, SegmentHit<T>& hit) const;
+		template<bool AnyHit>
+		void traversePacket(const Ray2<T>* rays, uint32_t count, SegmentHit<T>* hits) const;
+
+		std::vector<Node>        nodes;
+		std::vector<Segment2<T>> segments; // in leaf order
+		std::vector<uint32_t>    ids;      // original index of segments[i]
+	};
+
+	/*
+		Create a hierarchy over the given segments.
+	*/
+	template<typename T>
+	inline SegmentBVH<T>::SegmentBVH(std::span<const Segment2<T>> segments) { build(segments); }
+
+	/*
+		Build the hierarchy from scratch. Hit results refer to indices into 'segments'.
+
+		@param segments - the segments to index.
+	*/
+	template<typename T>
+	void SegmentBVH<T>::build(std::span<const Segment2<T>> input)
+	{
+		nodes.clear();
+		segments.clear();
+		ids.clear();
+		if (input.empty())
+			return;
+
+		std::vector<Build> prims(input.size());
+		for (uint32_t i = 0; i < input.size(); i++)
+		{
+			prims[i].bounds = AABB2<T>::of(input[i].a, input[i].b);
+			prims[i].centroid = prims[i].bounds.center();
+			prims[i].id = i;
+		}
+
+		nodes.reserve(2 * input.size());
+		buildNode(prims, 0, static_cast<uint32_t>(prims.size()), 0);
+
+		segments.resize(input.size());
+		ids.resize(input.size());
+		for (size_t i = 0; i < prims.size(); i++)
+		{
+			ids[i] = prims[i].id;
+			segments[i] = input[prims[i].id];
+		}
+	}
+
+	template<typename T>
+	inline void SegmentBVH<T>::setBounds(Node& node, const AABB2<T>& b)
+	{
+		node.min[0] = b.min.x; node.min[1] = b.min.y;
+		node.max[0] = b.max.x; node.max[1] = b.max.y;
+	}
+
+	/*
+		Build the subtree over prims[begin, end) and return its node index. Beyond
+		MaxSahDepth the split falls back to the median so the depth stays bounded by
+		the traversal stack even for adversarial input.
+	*/
+	template<typename T>
+	uint32_t SegmentBVH<T>::buildNode(std::vector<Build>& prims, uint32_t begin, uint32_t end, uint32_t depth)
+	{
+		uint32_t index = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+
+		AABB2<T> bounds = AABB2<T>::empty();
+		AABB2<T> centroids = AABB2<T>::empty();
+		for (uint32_t i = begin; i < end; i++)
+		{
+			bounds.expand(prims[i].bounds);
+			centroids.expand(prims[i].centroid);
+		}
+		setBounds(nodes[index], bounds);
+
+		uint32_t count = end - begin;
+		Vector2<T> size = centroids.extent();
+		int axis = size.x >= size.y ? 0 : 1;
+		T lo = centroids.min[axis];
+		T extent = size[axis];
+		if (count <= 2 || (extent <= 0 && count <= MaxLeafSize))
+		{
+			nodes[index].index = begin;
+			nodes[index].count = count;
+			return index;
+		}
+
+		uint32_t mid = begin + count / 2;
+		bool median = true;
+		if (extent > 0 && depth < MaxSahDepth)
+		{
+			//Bin the centroids and evaluate the SAH cost of every bin boundary.
+			struct Bin { AABB2<T> bounds = AABB2<T>::empty(); uint32_t count = 0; };
+			Bin bins[BinCount];
+			T scale = static_cast<T>(BinCount) / extent;
+			auto binOf = [&](const Build& p) {
+				uint32_t b = static_cast<uint32_t>((p.centroid[axis] - lo) * scale);
+				return b < BinCount ? b : BinCount - 1;
+			};
+			for (uint32_t i = begin; i < end; i++)
+			{
+				Bin& bin = bins[binOf(prims[i])];
+				bin.bounds.expand(prims[i].bounds);
+				bin.count++;
+			}
+
+			T rightCost[BinCount];
+			AABB2<T> acc = AABB2<T>::empty();
+			uint32_t accCount = 0;
+			for (uint32_t b = BinCount - 1; b > 0; b--)
+			{
+				acc.expand(bins[b].bounds);
+				accCount += bins[b].count;
+				rightCost[b] = accCount ? accCount * acc.perimeter() : 0;
+			}
+
+			T bestCost = std::numeric_limits<T>::max();
+			uint32_t bestSplit = 0;
+			acc = AABB2<T>::empty();
+			accCount = 0;
+			for (uint32_t b = 1; b < BinCount; b++)
+			{
+				acc.expand(bins[b - 1].bounds);
+				accCount += bins[b - 1].count;
+				T cost = (accCount ? accCount * acc.perimeter() : 0) + rightCost[b];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = b;
+				}
+			}
+
+			if (count <= MaxLeafSize && bestCost >= count * bounds.perimeter())
+			{
+				nodes[index].index = begin;
+				nodes[index].count = count;
+				return index;
+			}
+
+			Build* split = std::partition(prims.data() + begin, prims.data() + end, [&](const Build& p) { return binOf(p) < bestSplit; });
+			uint32_t at = static_cast<uint32_t>(split - prims.data());
+			if (at != begin && at != end)
+			{
+				mid = at;
+				median = false;
+			}
+		}
+		if (median)
+		{
+			std::nth_element(prims.data() + begin, prims.data() + mid, prims.data() + end,
+				[axis](const Build& a, const Build& b) { return a.centroid[axis] < b.centroid[axis]; });
+		}
+
+		buildNode(prims, begin, mid, depth + 1);
+		uint32_t right = buildNode(prims, mid, end, depth + 1);
+		nodes[index].index = right;
+		nodes[index].count = 0;
+		return index;
+	}
+
+	/*
+		Update segment positions and recompute all bounds without changing the tree
+		topology. Children always follow their parent in the node array, so one reverse
+		pass visits every child before its parent.
+
+		@param input - the segments in their original order, same count as at build time.
+	*/
+	template<typename T>
+	void SegmentBVH<T>::refit(std::span<const Segment2<T>> input)
+	{
+		for (size_t i = 0; i < segments.size(); i++)
+			segments[i] = input[ids[i]];
+
+		for (size_t n = nodes.size(); n-- > 0;)
+		{
+			Node& node = nodes[n];
+			AABB2<T> b = AABB2<T>::empty();
+			if (node.count)
+			{
+				for (uint32_t i = node.index; i < node.index + node.count; i++)
+				{
+					b.expand(segments[i].a);
+					b.expand(segments[i].b);
+				}
+			}
+			else
+			{
+				const Node& l = nodes[n + 1];
+				const Node& r = nodes[node.index];
+				b.min.set(std::min(l.min[0], r.min[0]), std::min(l.min[1], r.min[1]));
+				b.max.set(std::max(l.max[0], r.max[0]), std::max(l.max[1], r.max[1]));
+			}
+			setBounds(node, b);
+		}
+	}
+
+	/*
+		Slab test of a ray against a node box. Return the entry parameter, or
+		NoEntry when the box is not reached for t in [0, maxT].
+
+		A ray parallel to an axis has an infinite inverse direction there, and when it
+		starts exactly on a bound the product is 0 * inf = NaN. Such a ray runs along
+		the bound, so the NaN is replaced by the infinity that leaves the slab
+		unbounded: -invDir for the minimum, +invDir for the maximum.
+	*/
+	template<typename T>
+	inline T SegmentBVH<T>::entry(const Node& node, const Vector2<T>& origin, const Vector2<T>& invDir, T maxT)
+	{
+		T tx0 = (node.min[0] - origin.x) * invDir.x;
+		T tx1 = (node.max[0] - origin.x) * invDir.x;
+		T ty0 = (node.min[1] - origin.y) * invDir.y;
+		T ty1 = (node.max[1] - origin.y) * invDir.y;
+		tx0 = tx0 == tx0 ? tx0 : -invDir.x;
+		tx1 = tx1 == tx1 ? tx1 : invDir.x;
+		ty0 = ty0 == ty0 ? ty0 : -invDir.y;
+		ty1 = ty1 == ty1 ? ty1 : invDir.y;
+		T tmin = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), static_cast<T>(0));
+		T tmax = std::min(std::max(tx0, tx1), std::max(ty0, ty1));
+		return tmax >= tmin && tmin <= maxT ? tmin : NoEntry;
+	}
+
+	/*
+		Return the ray parameter where the ray crosses segment s, or a negative value
+		when they do not intersect. Parallel segments never intersect.
+	*/
+	template<typename T>
+	inline T SegmentBVH<T>::intersect(const Segment2<T>& s, const Vector2<T>& origin, const Vector2<T>& dir)
+	{
+		T ex = s.b.x - s.a.x, ey = s.b.y - s.a.y;
+		T denom = dir.x * ey - dir.y * ex;
+		if (denom == 0)
+			return -1;
+		T ox = s.a.x - origin.x, oy = s.a.y - origin.y;
+		T inv = static_cast<T>(1) / denom;
+		T t = (ox * ey - oy * ex) * inv;
+		T u = (ox * dir.y - oy * dir.x) * inv;
+		return u >= 0 && u <= 1 ? t : -1;
+	}
+
+	/*
+		Depth-first traversal visiting the nearer child first. Deferred children keep
+		their entry distance so they are dropped once a closer hit is known.
+	*/
+	template<typename T>
+	template<bool AnyHit>
+	void SegmentBVH<T>::traverse(const Ray2<T>& ray, SegmentHit<T>& hit) const
+	{
+		hit = { Miss, ray.maxT };
+		if (nodes.empty())
+			return;
+
+		Vector2<T> invDir(static_cast<T>(1) / ray.direction.x, static_cast<T>(1) / ray.direction.y);
+		struct Entry { uint32_t node; T t; } stack[StackSize];
+		uint32_t top = 0;
+		T t0 = entry(nodes[0], ray.origin, invDir, hit.t);
+		if (t0 != NoEntry)
+			stack[top++] = { 0, t0 };
+		while (top)
+		{
+			Entry e = stack[--top];
+			if (e.t > hit.t)
+				continue;
+			const Node& node = nodes[e.node];
+			if (node.count)
+			{
+				for (uint32_t i = node.index; i < node.index + node.count; i++)
+				{
+					T t = intersect(segments[i], ray.origin, ray.direction);
+					if (t >= 0 && t <= hit.t)
+					{
+						hit = { ids[i], t };
+						if constexpr (AnyHit)
+							return;
+					}
+				}
+				continue;
+			}
+
+			uint32_t l = e.node + 1, r = node.index;
+			T tl = entry(nodes[l], ray.origin, invDir, hit.t);
+			T tr = entry(nodes[r], ray.origin, invDir, hit.t);
+			if (tl > tr)
+			{
+				std::swap(l, r);
+				std::swap(tl, tr);
+			}
+			if (tr != NoEntry)
+				stack[top++] = { r, tr };
+			if (tl != NoEntry)
+				stack[top++] = { l, tl };
+		}
+	}
+
+	/*
+		Return the closest segment hit by the ray.
+	*/
+	template<typename T>
+	inline SegmentHit<T> SegmentBVH<T>::raycast(const Ray2<T>& ray) const
+	{
+		SegmentHit<T> hit;
+		traverse<false>(ray, hit);
+		return hit;
+	}
+
+	/*
+		Return true if any segment blocks the ray before ray.maxT, e.g. for line of
+		sight. Stops at the first hit found.
+	*/
+	template<typename T>
+	inline bool SegmentBVH<T>::occluded(const Ray2<T>& ray) const
+	{
+		SegmentHit<T> hit;
+		traverse<true>(ray, hit);
+		return hit.segment != Miss;
+	}
+
+	/*
+		Traverse the tree once for up to PacketSize rays. Every stack entry carries the
+		mask of rays that reached it, so leaves only test those rays. The per-ray box
+		tests are laid out over lane arrays so the compiler vectorizes them; coherent
+		rays (same shooter, nearby targets) share almost all of their node fetches.
+	*/
+	template<typename T>
+	template<bool AnyHit>
+	void SegmentBVH<T>::traversePacket(const Ray2<T>* rays, uint32_t count, SegmentHit<T>* hits) const
+	{
+		static_assert(PacketSize <= 32, "Packet masks are 32 bits wide.");
+		T ox[PacketSize], oy[PacketSize], ix[PacketSize], iy[PacketSize], tmax[PacketSize];
+		for (uint32_t r = 0; r < PacketSize; r++)
+		{
+			const Ray2<T>& ray = rays[r < count ? r : 0];
+			ox[r] = ray.origin.x;
+			oy[r] = ray.origin.y;
+			ix[r] = static_cast<T>(1) / ray.direction.x;
+			iy[r] = static_cast<T>(1) / ray.direction.y;
+			tmax[r] = r < count ? ray.maxT : -1;
+			if (r < count)
+				hits[r] = { Miss, ray.maxT };
+		}
+		if (nodes.empty())
+			return;
+
+		//Mask of the lanes reaching 'node', and the entry distance of the first one.
+		auto test = [&](const Node& node, uint32_t active, T& first) {
+			T tin[PacketSize];
+			int32_t reached[PacketSize];
+			for (uint32_t r = 0; r < PacketSize; r++)
+			{
+				T tx0 = (node.min[0] - ox[r]) * ix[r];
+				T tx1 = (node.max[0] - ox[r]) * ix[r];
+				T ty0 = (node.min[1] - oy[r]) * iy[r];
+				T ty1 = (node.max[1] - oy[r]) * iy[r];
+				//Axis-parallel lane starting on a bound, see entry().
+				tx0 = tx0 == tx0 ? tx0 : -ix[r];
+				tx1 = tx1 == tx1 ? tx1 : ix[r];
+				ty0 = ty0 == ty0 ? ty0 : -iy[r];
+				ty1 = ty1 == ty1 ? ty1 : iy[r];
+				T tmin = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), static_cast<T>(0));
+				T tout = std::min(std::max(tx0, tx1), std::max(ty0, ty1));
+				tin[r] = tmin;
+				reached[r] = (tout >= tmin) & (tmin <= tmax[r]);
+			}
+			uint32_t mask = 0;
+			for (uint32_t r = 0; r < PacketSize; r++)
+				mask |= static_cast<uint32_t>(reached[r]) << r;
+			mask &= active;
+			first = mask ? tin[std::countr_zero(mask)] : NoEntry;
+			return mask;
+		};
+
+		struct Entry { uint32_t node; uint32_t mask; } stack[StackSize];
+		uint32_t top = 0;
+		T first;
+		uint32_t rootMask = test(nodes[0], (1u << count) - 1, first);
+		if (rootMask)
+			stack[top++] = { 0, rootMask };
+		while (top)
+		{
+			Entry e = stack[--top];
+			const Node& node = nodes[e.node];
+			if constexpr (!AnyHit)
+			{
+				//Closer hits may have been found since this entry was deferred.
+				if (!(e.mask = test(node, e.mask, first)))
+					continue;
+			}
+			if (node.count)
+			{
+				for (uint32_t lanes = e.mask; lanes; lanes &= lanes - 1)
+				{
+					uint32_t r = std::countr_zero(lanes);
+					if (tmax[r] < 0)
+						continue;
+					for (uint32_t i = node.index; i < node.index + node.count; i++)
+					{
+						T t = intersect(segments[i], rays[r].origin, rays[r].direction);
+						if (t >= 0 && t <= tmax[r])
+						{
+							hits[r] = { ids[i], t };
+							tmax[r] = AnyHit ? static_cast<T>(-1) : t;
+							if constexpr (AnyHit)
+								break;
+						}
+					}
+				}
+				continue;
+			}
+
+			uint32_t l = e.node + 1, r = node.index;
+			T tl, tr;
+			uint32_t ml = test(nodes[l], e.mask, tl);
+			uint32_t mr = test(nodes[r], e.mask, tr);
+			if (tl > tr)
+			{
+				std::swap(l, r);
+				std::swap(ml, mr);
+			}
+			if (mr)
+				stack[top++] = { r, mr };
+			if (ml)
+				stack[top++] = { l, ml };
+		}
+	}
+
+	/*
+		Closest-hit query for a batch of rays, processed in packets of PacketSize.
+
+		@param rays - rays to cast.
+		@param hits - receives one result per ray.
+	*/
+	template<typename T>
+	void SegmentBVH<T>::raycast(std::span<const Ray2<T>> rays, std::span<SegmentHit<T>> hits) const
+	{
+		assert(rays.size() == hits.size());
+		for (size_t i = 0; i < rays.size(); i += PacketSize)
+		{
+			uint32_t n = static_cast<uint32_t>(std::min<size_t>(PacketSize, rays.size() - i));
+			traversePacket<false>(rays.data() + i, n, hits.data() + i);
+		}
+	}
+
+	/*
+		Line-of-sight query for a batch of rays, processed in packets of PacketSize.
+
+		@param rays - rays to test; only hits before each ray's maxT count.
+		@param result - receives true for every blocked ray.
+	*/
+	template<typename T>
+	void SegmentBVH<T>::occluded(std::span<const Ray2<T>> rays, std::span<bool> result) const
+	{
+		assert(rays.size() == result.size());
+		SegmentHit<T> hits[PacketSize];
+		for (size_t i = 0; i < rays.size(); i += PacketSize)
+		{
+			uint32_t n = static_cast<uint32_t>(std::min<size_t>(PacketSize, rays.size() - i));
+			traversePacket<true>(rays.data() + i, n, hits);
+			for (uint32_t r = 0; r < n; r++)
+				result[i + r] = hits[r].segment != Miss;
+		}
+	}
+}
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <type_traits>
+
+/*
+	SIMD backend shared by every vector type. The widest instruction set enabled at
+	compile time is used (AVX, then SSE2); define FORCEML_NO_SIMD to force the scalar
+	path. All vector code goes through Simd::Pack so a new backend only has to be
+	added here.
+*/
+#ifndef FORCEML_NO_SIMD
+#if defined(__AVX__)
+#define FORCEML_SIMD_AVX
+#define FORCEML_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FORCEML_SIMD_SSE2
+#endif
+#endif
+
+#if defined(FORCEML_SIMD_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace Force::Math::Simd
+{
+	/*
+		One-lane scalar register. Used for component types without a native backend and
+		for the tail of every batch loop.
+	*/
+	template<typename T>
+	struct Scalar
+	{
+		using Type = T;
+		static constexpr size_t Width = 1;
+		T v;
+
+		static Scalar load(const T* p) { return { *p }; }
+		static Scalar convert(const uint32_t* p) { return { static_cast<T>(*p) }; }
+		static Scalar gather(const T* base, const int32_t* index) { return { base[*index] }; }
+		static Scalar broadcast(T s) { return { s }; }
+		void          store(T* p) const { *p = v; }
+
+		friend Scalar operator+(Scalar a, Scalar b) { return { static_cast<T>(a.v + b.v) }; }
+		friend Scalar operator-(Scalar a, Scalar b) { return { static_cast<T>(a.v - b.v) }; }
+		friend Scalar operator*(Scalar a, Scalar b) { return { static_cast<T>(a.v * b.v) }; }
+		friend Scalar operator/(Scalar a, Scalar b) { return { static_cast<T>(a.v / b.v) }; }
+		friend Scalar operator^(Scalar a, Scalar b) { return { static_cast<T>(a.v ^ b.v) }; }
+		friend Scalar operator>>(Scalar a, int n) { return { static_cast<T>(a.v >> n) }; }
+	};
+
+	template<typename T>
+	inline Scalar<T> min(Scalar<T> a, Scalar<T> b) { return { a.v < b.v ? a.v : b.v }; }
+	template<typename T>
+	inline Scalar<T> max(Scalar<T> a, Scalar<T> b) { return { a.v > b.v ? a.v : b.v }; }
+	template<typename T>
+	inline Scalar<T> fma(Scalar<T> a, Scalar<T> b, Scalar<T> c) { return { static_cast<T>(a.v * b.v + c.v) }; }
+	template<typename T>
+	inline Scalar<T> sqrt(Scalar<T> a) { return { static_cast<T>(std::sqrt(a.v)) }; }
+
+	/*
+		Split positive, normal, finite lanes into x = m * 2^e with m in [1, 2). The
+		exponent is returned as an integral value of the lane type.
+	*/
+	template<typename T>
+	inline void frexp(Scalar<T> x, Scalar<T>& m, Scalar<T>& e)
+	{
+		int k;
+		m.v = static_cast<T>(2) * std::frexp(x.v, &k);
+		e.v = static_cast<T>(k - 1);
+	}
+
+	/*
+		Full 64-bit products of unsigned 32-bit lanes, split into the high and the low
+		halves.
+	*/
+	inline void mulhilo(Scalar<uint32_t> a, Scalar<uint32_t> b, Scalar<uint32_t>& hi, Scalar<uint32_t>& lo)
+	{
+		uint64_t p = static_cast<uint64_t>(a.v) * b.v;
+		hi.v = static_cast<uint32_t>(p >> 32);
+		lo.v = static_cast<uint32_t>(p);
+	}
+
+	/*
+		Split two registers holding interleaved pairs (x0 y0 x1 y1 ...) into one
+		register of x and one of y, and the reverse. With one lane the pair is simply
+		the two registers.
+	*/
+	template<typename T>
+	inline void deinterleave(Scalar<T> a, Scalar<T> b, Scalar<T>& even, Scalar<T>& odd) { even = a; odd = b; }
+	template<typename T>
+	inline void interleave(Scalar<T> even, Scalar<T> odd, Scalar<T>& a, Scalar<T>& b) { a = even; b = odd; }
+
+	/*
+		Maps a component type to its widest native register. Specialized below for
+		every instruction set the backend knows.
+	*/
+	template<typename T>
+	struct Native { using Type = Scalar<T>; };
+
+#if defined(FORCEML_SIMD_AVX)
+	struct PackF32
+	{
+		using Type = float;
+		static constexpr size_t Width = 8;
+		__m256 v;
+
+		static PackF32 load(const float* p) { return { _mm256_loadu_ps(p) }; }
+		//Load unsigned integers below 2^31 and convert them to float.
+		static PackF32 convert(const uint32_t* p) { return { _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))) }; }
+		static PackF32 gather(const float* base, const int32_t* index)
+		{
+#if defined(__AVX2__)
+			//The masked form with an explicit source avoids reading an undefined register.
+			__m256i i = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index));
+			return { _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, i, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4) };
+#else
+			return { _mm256_setr_ps(base[index[0]], base[index[1]], base[index[2]], base[index[3]],
+			                        base[index[4]], base[index[5]], base[index[6]], base[index[7]]) };
+#endif
+		}
+		static PackF32 broadcast(float s) { return { _mm256_set1_ps(s) }; }
+		void           store(float* p) const { _mm256_storeu_ps(p, v); }
+
+		friend PackF32 operator+(PackF32 a, PackF32 b) { return { _mm256_add_ps(a.v, b.v) }; }
+		friend PackF32 operator-(PackF32 a, PackF32 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+		friend PackF32 operator*(PackF32 a, PackF32 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+		friend PackF32 operator/(PackF32 a, PackF32 b) { return { _mm256_div_ps(a.v, b.v) }; }
+	};
+
+	inline PackF32 min(PackF32 a, PackF32 b) { return { _mm256_min_ps(a.v, b.v) }; }
+	inline PackF32 max(PackF32 a, PackF32 b) { return { _mm256_max_ps(a.v, b.v) }; }
+#if defined(__FMA__)
+	inline PackF32 fma(PackF32 a, PackF32 b, PackF32 c) { return { _mm256_fmadd_ps(a.v, b.v, c.v) }; }
+#else
+	inline PackF32 fma(PackF32 a, PackF32 b, PackF32 c) { return { _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v) }; }
+#endif
+	inline PackF32 sqrt(PackF32 a) { return { _mm256_sqrt_ps(a.v) }; }
+	inline void    frexp(PackF32 x, PackF32& m, PackF32& e)
+	{
+		__m256 mantissa = _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF));
+		__m256 exponent = _mm256_castsi256_ps(_mm256_set1_epi32(0x7F800000));
+		m.v = _mm256_or_ps(_mm256_and_ps(x.v, mantissa), _mm256_set1_ps(1.0f));
+		//The biased exponent field read as an integer is (e + 127) * 2^23, exact in float.
+		__m256 biased = _mm256_cvtepi32_ps(_mm256_castps_si256(_mm256_and_ps(x.v, exponent)));
+		e.v = _mm256_sub_ps(_mm256_mul_ps(biased, _mm256_set1_ps(0x1p-23f)), _mm256_set1_ps(127.0f));
+	}
+	inline void    deinterleave(PackF32 a, PackF32 b, PackF32& even, PackF32& odd)
+	{
+		__m256 lo = _mm256_permute2f128_ps(a.v, b.v, 0x20);
+		__m256 hi = _mm256_permute2f128_ps(a.v, b.v, 0x31);
+		even.v = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+		odd.v = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+	inline void    interleave(PackF32 even, PackF32 odd, PackF32& a, PackF32& b)
+	{
+		__m256 lo = _mm256_unpacklo_ps(even.v, odd.v);
+		__m256 hi = _mm256_unpackhi_ps(even.v, odd.v);
+		a.v = _mm256_permute2f128_ps(lo, hi, 0x20);
+		b.v = _mm256_permute2f128_ps(lo, hi, 0x31);
+	}
+
+	struct PackF64
+	{
+		using Type = double;
+		static constexpr size_t Width = 4;
+		__m256d v;
+
+		static PackF64 load(const double* p) { return { _mm256_loadu_pd(p) }; }
+		//Load unsigned integers and convert them to double, exactly: biased into signed range and back.
+		static PackF64 convert(const uint32_t* p)
+		{
+			__m128i i = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi32(INT32_MIN));
+			return { _mm256_add_pd(_mm256_cvtepi32_pd(i), _mm256_set1_pd(2147483648.0)) };
+		}
+		static PackF64 gather(const double* base, const int32_t* index)
+		{
+#if defined(__AVX2__)
+			__m128i i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index));
+			return { _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, i, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8) };
+#else
+			return { _mm256_setr_pd(base[index[0]], base[index[1]], base[index[2]], base[index[3]]) };
+#endif
+		}
+		static PackF64 broadcast(double s) { return { _mm256_set1_pd(s) }; }
+		void           store(double* p) const { _mm256_storeu_pd(p, v); }
+
+		friend PackF64 operator+(PackF64 a, PackF64 b) { return { _mm256_add_pd(a.v, b.v) }; }
+		friend PackF64 operator-(PackF64 a, PackF64 b) { return { _mm256_sub_pd(a.v, b.v) }; }
+		friend PackF64 operator*(PackF64 a, PackF64 b) { return { _mm256_mul_pd(a.v, b.v) }; }
+		friend PackF64 operator/(PackF64 a, PackF64 b) { return { _mm256_div_pd(a.v, b.v) }; }
+	};
+
+	inline PackF64 min(PackF64 a, PackF64 b) { return { _mm256_min_pd(a.v, b.v) }; }
+	inline PackF64 max(PackF64 a, PackF64 b) { return { _mm256_max_pd(a.v, b.v) }; }
+#if defined(__FMA__)
+	inline PackF64 fma(PackF64 a, PackF64 b, PackF64 c) { return { _mm256_fmadd_pd(a.v, b.v, c.v) }; }
+#else
+	inline PackF64 fma(PackF64 a, PackF64 b, PackF64 c) { return { _mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v) }; }
+#endif
+	inline PackF64 sqrt(PackF64 a) { return { _mm256_sqrt_pd(a.v) }; }
+	inline void    frexp(PackF64 x, PackF64& m, PackF64& e)
+	{
+		__m256d mantissa = _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFF));
+		m.v = _mm256_or_pd(_mm256_and_pd(x.v, mantissa), _mm256_set1_pd(1.0));
+		//Shifted down into the mantissa of 2^52, the biased exponent converts by subtraction.
+		__m256i bits = _mm256_castpd_si256(x.v);
+#if defined(__AVX2__)
+		__m256i biased = _mm256_srli_epi64(bits, 52);
+#else
+		__m256i biased = _mm256_insertf128_si256(_mm256_castsi128_si256(_mm_srli_epi64(_mm256_castsi256_si128(bits), 52)),
+		                                         _mm_srli_epi64(_mm256_extractf128_si256(bits, 1), 52), 1);
+#endif
+		e.v = _mm256_sub_pd(_mm256_or_pd(_mm256_castsi256_pd(biased), _mm256_set1_pd(0x1p52)), _mm256_set1_pd(0x1p52 + 1023));
+	}
+	inline void    deinterleave(PackF64 a, PackF64 b, PackF64& even, PackF64& odd)
+	{
+		__m256d lo = _mm256_permute2f128_pd(a.v, b.v, 0x20);
+		__m256d hi = _mm256_permute2f128_pd(a.v, b.v, 0x31);
+		even.v = _mm256_unpacklo_pd(lo, hi);
+		odd.v = _mm256_unpackhi_pd(lo, hi);
+	}
+	inline void    interleave(PackF64 even, PackF64 odd, PackF64& a, PackF64& b)
+	{
+		__m256d lo = _mm256_unpacklo_pd(even.v, odd.v);
+		__m256d hi = _mm256_unpackhi_pd(even.v, odd.v);
+		a.v = _mm256_permute2f128_pd(lo, hi, 0x20);
+		b.v = _mm256_permute2f128_pd(lo, hi, 0x31);
+	}
+
+	/*
+		Convert between precisions. A float register holds exactly two double
+		registers' worth of lanes, so narrowing takes two and widening yields two, in order.
+	*/
+	inline PackF32 narrow(PackF64 a, PackF64 b)
+	{
+		return { _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(a.v)), _mm256_cvtpd_ps(b.v), 1) };
+	}
+	inline void    widen(PackF32 f, PackF64& a, PackF64& b)
+	{
+		a.v = _mm256_cvtps_pd(_mm256_castps256_ps128(f.v));
+		b.v = _mm256_cvtps_pd(_mm256_extractf128_ps(f.v, 1));
+	}
+#elif defined(FORCEML_SIMD_SSE2)
+	struct PackF32
+	{
+		using Type = float;
+		static constexpr size_t Width = 4;
+		__m128 v;
+
+		static PackF32 load(const float* p) { return { _mm_loadu_ps(p) }; }
+		//Load unsigned integers below 2^31 and convert them to float.
+		static PackF32 convert(const uint32_t* p) { return { _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) }; }
+		static PackF32 gather(const float* base, const int32_t* index)
+		{
+			return { _mm_setr_ps(base[index[0]], base[index[1]], base[index[2]], base[index[3]]) };
+		}
+		static PackF32 broadcast(float s) { return { _mm_set1_ps(s) }; }
+		void           store(float* p) const { _mm_storeu_ps(p, v); }
+
+		friend PackF32 operator+(PackF32 a, PackF32 b) { return { _mm_add_ps(a.v, b.v) }; }
+		friend PackF32 operator-(PackF32 a, PackF32 b) { return { _mm_sub_ps(a.v, b.v) }; }
+		friend PackF32 operator*(PackF32 a, PackF32 b) { return { _mm_mul_ps(a.v, b.v) }; }
+		friend PackF32 operator/(PackF32 a, PackF32 b) { return { _mm_div_ps(a.v, b.v) }; }
+	};
+
+	inline PackF32 min(PackF32 a, PackF32 b) { return { _mm_min_ps(a.v, b.v) }; }
+	inline PackF32 max(PackF32 a, PackF32 b) { return { _mm_max_ps(a.v, b.v) }; }
+	inline PackF32 fma(PackF32 a, PackF32 b, PackF32 c) { return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) }; }
+	inline PackF32 sqrt(PackF32 a) { return { _mm_sqrt_ps(a.v) }; }
+	inline void    frexp(PackF32 x, PackF32& m, PackF32& e)
+	{
+		__m128 mantissa = _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF));
+		m.v = _mm_or_ps(_mm_and_ps(x.v, mantissa), _mm_set1_ps(1.0f));
+		__m128i biased = _mm_srli_epi32(_mm_castps_si128(x.v), 23);
+		e.v = _mm_sub_ps(_mm_cvtepi32_ps(biased), _mm_set1_ps(127.0f));
+	}
+	inline void    deinterleave(PackF32 a, PackF32 b, PackF32& even, PackF32& odd)
+	{
+		even.v = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(2, 0, 2, 0));
+		odd.v = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+	inline void    interleave(PackF32 even, PackF32 odd, PackF32& a, PackF32& b)
+	{
+		a.v = _mm_unpacklo_ps(even.v, odd.v);
+		b.v = _mm_unpackhi_ps(even.v, odd.v);
+	}
+
+	struct PackF64
+	{
+		using Type = double;
+		static constexpr size_t Width = 2;
+		__m128d v;
+
+		static PackF64 load(const double* p) { return { _mm_loadu_pd(p) }; }
+		//Load unsigned integers and convert them to double, exactly: biased into signed range and back.
+		static PackF64 convert(const uint32_t* p)
+		{
+			__m128i i = _mm_xor_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi32(INT32_MIN));
+			return { _mm_add_pd(_mm_cvtepi32_pd(i), _mm_set1_pd(2147483648.0)) };
+		}
+		static PackF64 gather(const double* base, const int32_t* index) { return { _mm_setr_pd(base[index[0]], base[index[1]]) }; }
+		static PackF64 broadcast(double s) { return { _mm_set1_pd(s) }; }
+		void           store(double* p) const { _mm_storeu_pd(p, v); }
+
+		friend PackF64 operator+(PackF64 a, PackF64 b) { return { _mm_add_pd(a.v, b.v) }; }
+		friend PackF64 operator-(PackF64 a, PackF64 b) { return { _mm_sub_pd(a.v, b.v) }; }
+		friend PackF64 operator*(PackF64 a, PackF64 b) { return { _mm_mul_pd(a.v, b.v) }; }
+		friend PackF64 operator/(PackF64 a, PackF64 b) { return { _mm_div_pd(a.v, b.v) }; }
+	};
+
+	inline PackF64 min(PackF64 a, PackF64 b) { return { _mm_min_pd(a.v, b.v) }; }
+	inline PackF64 max(PackF64 a, PackF64 b) { return { _mm_max_pd(a.v, b.v) }; }
+	inline PackF64 fma(PackF64 a, PackF64 b, PackF64 c) { return { _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v) }; }
+	inline PackF64 sqrt(PackF64 a) { return { _mm_sqrt_pd(a.v) }; }
+	inline void    frexp(PackF64 x, PackF64& m, PackF64& e)
+	{
+		__m128d mantissa = _mm_castsi128_pd(_mm_set1_epi64x(0x000FFFFFFFFFFFFF));
+		m.v = _mm_or_pd(_mm_and_pd(x.v, mantissa), _mm_set1_pd(1.0));
+		__m128i biased = _mm_srli_epi64(_mm_castpd_si128(x.v), 52);
+		e.v = _mm_sub_pd(_mm_or_pd(_mm_castsi128_pd(biased), _mm_set1_pd(0x1p52)), _mm_set1_pd(0x1p52 + 1023));
+	}
+	inline void    deinterleave(PackF64 a, PackF64 b, PackF64& even, PackF64& odd)
+	{
+		even.v = _mm_unpacklo_pd(a.v, b.v);
+		odd.v = _mm_unpackhi_pd(a.v, b.v);
+	}
+	inline void    interleave(PackF64 even, PackF64 odd, PackF64& a, PackF64& b)
+	{
+		a.v = _mm_unpacklo_pd(even.v, odd.v);
+		b.v = _mm_unpackhi_pd(even.v, odd.v);
+	}
+
+	inline PackF32 narrow(PackF64 a, PackF64 b) { return { _mm_movelh_ps(_mm_cvtpd_ps(a.v), _mm_cvtpd_ps(b.v)) }; }
+	inline void    widen(PackF32 f, PackF64& a, PackF64& b)
+	{
+		a.v = _mm_cvtps_pd(f.v);
+		b.v = _mm_cvtps_pd(_mm_movehl_ps(f.v, f.v));
+	}
+#endif
+
+	/*
+		Unsigned 32-bit integer register for integer kernels such as random number
+		generation. Plain AVX has no 256-bit integer arithmetic, so it is 256 bits wide
+		only with AVX2 and takes the SSE2 form otherwise; its width therefore need not
+		match PackF32.
+	*/
+#if defined(FORCEML_SIMD_AVX) && defined(__AVX2__)
+	struct PackU32
+	{
+		using Type = uint32_t;
+		static constexpr size_t Width = 8;
+		__m256i v;
+
+		static PackU32 load(const uint32_t* p) { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) }; }
+		static PackU32 broadcast(uint32_t s) { return { _mm256_set1_epi32(static_cast<int>(s)) }; }
+		void           store(uint32_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+		friend PackU32 operator+(PackU32 a, PackU32 b) { return { _mm256_add_epi32(a.v, b.v) }; }
+		friend PackU32 operator^(PackU32 a, PackU32 b) { return { _mm256_xor_si256(a.v, b.v) }; }
+		friend PackU32 operator>>(PackU32 a, int n) { return { _mm256_srli_epi32(a.v, n) }; }
+	};
+
+	inline void mulhilo(PackU32 a, PackU32 b, PackU32& hi, PackU32& lo)
+	{
+		//Even lanes multiply in place, odd lanes after shifting them down.
+		__m256i even = _mm256_mul_epu32(a.v, b.v);
+		__m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a.v, 32), _mm256_srli_epi64(b.v, 32));
+		hi.v = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+		lo.v = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+	}
+#elif defined(FORCEML_SIMD_SSE2)
+	struct PackU32
+	{
+		using Type = uint32_t;
+		static constexpr size_t Width = 4;
+		__m128i v;
+
+		static PackU32 load(const uint32_t* p) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) }; }
+		static PackU32 broadcast(uint32_t s) { return { _mm_set1_epi32(static_cast<int>(s)) }; }
+		void           store(uint32_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+		friend PackU32 operator+(PackU32 a, PackU32 b) { return { _mm_add_epi32(a.v, b.v) }; }
+		friend PackU32 operator^(PackU32 a, PackU32 b) { return { _mm_xor_si128(a.v, b.v) }; }
+		friend PackU32 operator>>(PackU32 a, int n) { return { _mm_srli_epi32(a.v, n) }; }
+	};
+
+	inline void mulhilo(PackU32 a, PackU32 b, PackU32& hi, PackU32& lo)
+	{
+		__m128i even = _mm_mul_epu32(a.v, b.v);
+		__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+		hi.v = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(3, 3, 3, 1)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(3, 3, 3, 1)));
+		lo.v = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(2, 2, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(2, 2, 2, 0)));
+	}
+#endif
+
+#if defined(FORCEML_SIMD_SSE2)
+	template<> struct Native<float>    { using Type = PackF32; };
+	template<> struct Native<double>   { using Type = PackF64; };
+	template<> struct Native<uint32_t> { using Type = PackU32; };
+#endif
+
+	/*A register of the widest native width for T.*/
+	template<typename T>
+	using Pack = typename Native<T>::Type;
+
+	/*
+		Apply 'op' lane-wise over n elements: d[i] = op(src[i]...). The main loop runs on
+		full packs and the tail on one-lane scalars, so 'op' must be a generic callable
+		that accepts either register type.
+	*/
+	template<typename T, typename F, typename... Src>
+	inline void transform(T* d, size_t n, F&& op, const Src*... src)
+	{
+		using P = Pack<T>;
+		size_t i = 0;
+		for (; i + P::Width <= n; i += P::Width)
+			op(P::load(src + i)...).store(d + i);
+		for (; i < n; i++)
+			op(Scalar<T>::load(src + i)...).store(d + i);
+	}
+
+	/*
+		Round every lane to the nearest integer, ties to even, for |x| below 2^22
+		(float) or 2^51 (double): adding and removing 1.5 * 2^mantissa bits leaves no
+		fractional bits in between.
+	*/
+	template<typename P>
+	inline P round(P x)
+	{
+		using T = typename P::Type;
+		const P magic = P::broadcast(std::is_same_v<T, float> ? static_cast<T>(0x1.8p23f) : static_cast<T>(0x1.8p52));
+		return (x + magic) - magic;
+	}
+
+	/*
+		Sine and cosine of every lane, within 2 ulp for |x| below 8 (float) or 2^30
+		(double). Larger float arguments keep an absolute error below 5e-7 up to 2^14
+		but lose relative accuracy near the zeros. The argument is reduced by the nearest multiple q of pi/2 in
+		three parts (Cody-Waite) and both functions are evaluated by the Cephes
+		polynomials on [-pi/4, pi/4]; the quadrant q mod 4 then selects and negates
+		them through factors of -1, 0 and 1, which keeps the selection exact without
+		lane masks.
+	*/
+	template<typename P>
+	inline void sincos(P x, P& s, P& c)
+	{
+		using T = typename P::Type;
+		auto k = [](double f) { return P::broadcast(static_cast<T>(f)); };
+		P q = round(x * k(0.636619772367581343076));
+		P r, z, sr, cr;
+		if constexpr (std::is_same_v<T, float>)
+		{
+			r = ((x - q * k(1.5703125)) - q * k(4.837512969970703125e-4)) - q * k(7.54978995489188216e-8);
+			z = r * r;
+			sr = r + r * z * ((k(-1.9515295891e-4) * z + k(8.3321608736e-3)) * z + k(-1.6666654611e-1));
+			cr = k(1) - k(0.5) * z + z * z * ((k(2.443315711809948e-5) * z + k(-1.388731625493765e-3)) * z + k(4.166664568298827e-2));
+		}
+		else
+		{
+			r = ((x - q * k(1.57079625129699707031)) - q * k(7.54978941586159635335e-8)) - q * k(5.39030285815811905290e-15);
+			z = r * r;
+			P ps = k(1.58962301576546568060e-10);
+			for (double f : { -2.50507477628578072866e-8, 2.75573136213857245213e-6, -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1 })
+				ps = ps * z + k(f);
+			P pc = k(-1.13585365213876817300e-11);
+			for (double f : { 2.08757008419747316778e-9, -2.75573141792967388112e-7, 2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2 })
+				pc = pc * z + k(f);
+			sr = r + r * z * ps;
+			cr = k(1) - k(0.5) * z + z * z * pc;
+		}
+
+		//m = q mod 4; a = cos(m pi / 2), b = -sin(m pi / 2).
+		P m = q - k(4) * round(q * k(0.25) - k(0.375));
+		P a = max(m - k(2), k(2) - m) - k(1);
+		P b = max(m - k(1), k(1) - m) - k(1);
+		c = a * cr + b * sr;
+		s = a * sr - b * cr;
+	}
+
+	/*
+		Natural logarithm of every lane, for positive, normal, finite x. The mantissa
+		is brought into [sqrt(1/2), sqrt(2)) so that log(m) = 2 atanh((m - 1) / (m + 1))
+		has a small argument and never cancels against the exponent term near x = 1.
+	*/
+	template<typename P>
+	inline P log(P x)
+	{
+		using T = typename P::Type;
+		auto k = [](double f) { return P::broadcast(static_cast<T>(f)); };
+		P m, e;
+		frexp(x, m, e);
+		//1 when m >= sqrt(2), else 0; halving m then is exact.
+		P high = round(m - k(1.41421356237309504880 - 0.5));
+		m = m * (k(1) - k(0.5) * high);
+		e = e + high;
+
+		P t = (m - k(1)) / (m + k(1));
+		P z = t * t;
+		//atanh(t) / t - 1 = z / 3 + z^2 / 5 + ..., truncated below the lane precision.
+		constexpr int Terms = std::is_same_v<T, float> ? 5 : 10;
+		P p = k(1.0 / (2 * Terms + 1));
+		for (int i = Terms - 1; i >= 1; i--)
+			p = p * z + k(1.0 / (2 * i + 1));
+		P logm = t + t + (t + t) * z * p;
+		if constexpr (std::is_same_v<T, float>)
+			return e * k(0.693359375) + (e * k(-2.12194440e-4) + logm);
+		else
+			return e * k(6.93147180369123816490e-1) + (e * k(1.90821492927058770002e-10) + logm);
+	}
+}
@@ -0,0 +1,346 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "TypeAABB2.h"
+
+namespace Force::Math
+{
+	/*
+		Incremental sweep-and-prune broadphase over two-dimensional boxes.
+
+		Both axes keep a sorted array of box endpoints between steps. Boxes usually
+		move little per tick, so re-sorting with insertion sort costs a linear pass
+		plus one swap per endpoint that actually crossed another. Every swap of a
+		minimum past a maximum (or the reverse) is exactly an overlap starting or ending
+		on that axis, which is turned into added / removed pair events; pairs that did
+		not change produce no work at all.
+
+		Box bounds are kept structure-of-arrays so the full rebuild and box queries can
+		test many boxes at once.
+	*/
+	template<typename T>
+	class SweepAndPrune
+	{
+	public:
+		using Handle = uint32_t;
+
+		/*An overlapping pair, always stored with a < b.*/
+		struct Pair
+		{
+			Handle a, b;
+		};
+
+		Handle add(const AABB2<T>& box);
+		void   remove(Handle h);
+		void   update(Handle h, const AABB2<T>& box);
+		void   step(std::vector<Pair>& added, std::vector<Pair>& removed);
+		void   rebuild(std::vector<Pair>& added, std::vector<Pair>& removed);
+		void   query(const AABB2<T>& box, std::vector<Handle>& out) const;
+
+		bool   isOverlapping(Handle a, Handle b) const { return pairs.count(key(a, b)) != 0; }
+		size_t getPairCount() const { return pairs.size(); }
+
+	private:
+		/*One end of a box on an axis. id is the box handle shifted left, low bit set for the maximum.*/
+		struct Endpoint
+		{
+			T        value;
+			uint32_t id;
+		};
+
+		static uint64_t key(Handle a, Handle b)
+		{
+			return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+		}
+		static bool less(const Endpoint& a, const Endpoint& b)
+		{
+			return a.value < b.value || (a.value == b.value && (a.id & 1) < (b.id & 1));
+		}
+
+		bool overlaps(Handle a, Handle b) const;
+		void addPair(Handle a, Handle b);
+		void removePair(Handle a, Handle b);
+		void record(uint64_t k, bool started);
+		void flush(std::vector<Pair>& added, std::vector<Pair>& removed);
+		void sortAxis(int axis);
+
+		std::vector<T>        lo[2], hi[2];
+		std::vector<uint8_t>  alive;
+		std::vector<Handle>   freeList;
+		std::vector<Endpoint> axes[2];
+
+		std::unordered_set<uint64_t>       pairs;
+		std::unordered_map<uint64_t, bool> pending;
+	};
+
+	/*
+		Insert a box and return its handle. Its overlaps are reported by the next step().
+
+		@param box - initial bounds.
+	*/
+	template<typename T>
+	typename SweepAndPrune<T>::Handle SweepAndPrune<T>::add(const AABB2<T>& box)
+	{
+		Handle h;
+		if (!freeList.empty())
+		{
+			h = freeList.back();
+			freeList.pop_back();
+		}
+		else
+		{
+			h = static_cast<Handle>(alive.size());
+			alive.push_back(0);
+			for (int k = 0; k < 2; k++)
+			{
+				lo[k].push_back(0);
+				hi[k].push_back(0);
+			}
+		}
+		alive[h] = 1;
+		update(h, box);
+
+		//Appended endpoints behave like a box arriving from +infinity; the next
+		//insertion sort moves them into place and reports the overlaps it crosses.
+		for (int k = 0; k < 2; k++)
+		{
+			axes[k].push_back({ lo[k][h], h << 1 });
+			axes[k].push_back({ hi[k][h], (h << 1) | 1 });
+		}
+		return h;
+	}
+
+	/*
+		Remove a box. Its current pairs are reported as removed by the next step(),
+		unless the handle is reused by add() and overlaps the same boxes again before
+		then. Costs a pass over all endpoints and all pairs, O(n + pairs), so it is
+		meant for occasional removals rather than churning most boxes every tick.
+
+		@param h - handle returned by add().
+	*/
+	template<typename T>
+	void SweepAndPrune<T>::remove(Handle h)
+	{
+		assert(h < alive.size() && alive[h]);
+		for (int k = 0; k < 2; k++)
+			std::erase_if(axes[k], [h](const Endpoint& e) { return (e.id >> 1) == h; });
+
+		for (auto it = pairs.begin(); it != pairs.end();)
+		{
+			Handle a = static_cast<Handle>(*it >> 32), b = static_cast<Handle>(*it);
+			if (a == h || b == h)
+			{
+				record(*it, false);
+				it = pairs.erase(it);
+			}
+			else
+				++it;
+		}
+		alive[h] = 0;
+		freeList.push_back(h);
+	}
+
+	/*
+		Set new bounds for a box. Only the bounds are written; sorting and pair
+		events happen in step().
+
+		@param h - handle returned by add().
+		@param box - new bounds, min must not exceed max.
+	*/
+	template<typename T>
+	inline void SweepAndPrune<T>::update(Handle h, const AABB2<T>& box)
+	{
+		assert(!box.isEmpty());
+		lo[0][h] = box.min.x; hi[0][h] = box.max.x;
+		lo[1][h] = box.min.y; hi[1][h] = box.max.y;
+	}
+
+	template<typename T>
+	inline bool SweepAndPrune<T>::overlaps(Handle a, Handle b) const
+	{
+		return lo[0][a] <= hi[0][b] && lo[0][b] <= hi[0][a] && lo[1][a] <= hi[1][b] && lo[1][b] <= hi[1][a];
+	}
+
+	template<typename T>
+	inline void SweepAndPrune<T>::addPair(Handle a, Handle b)
+	{
+		if (pairs.insert(key(a, b)).second)
+			record(key(a, b), true);
+	}
+
+	template<typename T>
+	inline void SweepAndPrune<T>::removePair(Handle a, Handle b)
+	{
+		if (pairs.erase(key(a, b)))
+			record(key(a, b), false);
+	}
+
+	/*
+		Note that a pair started or stopped overlapping. An event that undoes one
+		still pending since the last step cancels it, so a pair that ends the tick as
+		it began is not reported at all.
+	*/
+	template<typename T>
+	inline void SweepAndPrune<T>::record(uint64_t k, bool started)
+	{
+		auto [it, fresh] = pending.try_emplace(k, started);
+		if (!fresh && it->second != started)
+			pending.erase(it);
+	}
+
+	template<typename T>
+	void SweepAndPrune<T>::flush(std::vector<Pair>& added, std::vector<Pair>& removed)
+	{
+		for (const auto& [k, started] : pending)
+			(started ? added : removed).push_back({ static_cast<Handle>(k >> 32), static_cast<Handle>(k) });
+		pending.clear();
+	}
+
+	/*
+		Refresh the endpoint values of one axis and restore its order by insertion
+		sort, turning crossings into pair events.
+	*/
+	template<typename T>
+	void SweepAndPrune<T>::sortAxis(int axis)
+	{
+		std::vector<Endpoint>& e = axes[axis];
+		const T* l = lo[axis].data();
+		const T* u = hi[axis].data();
+		for (Endpoint& p : e)
+			p.value = (p.id & 1) ? u[p.id >> 1] : l[p.id >> 1];
+
+		for (size_t i = 1; i < e.size(); i++)
+		{
+			Endpoint cur = e[i];
+			size_t j = i;
+			while (j > 0 && less(cur, e[j - 1]))
+			{
+				const Endpoint& prev = e[j - 1];
+				Handle a = cur.id >> 1, b = prev.id >> 1;
+				bool curMax = cur.id & 1, prevMax = prev.id & 1;
+				//A minimum moving below a maximum starts an overlap on this axis, a
+				//maximum moving below a minimum ends one.
+				if (!curMax && prevMax && overlaps(a, b))
+					addPair(a, b);
+				else if (curMax && !prevMax)
+					removePair(a, b);
+				e[j] = prev;
+				j--;
+			}
+			e[j] = cur;
+		}
+	}
+
+	/*
+		Bring the pair set up to date with the current bounds and append the pairs
+		that started or stopped overlapping since the last step (including those
+		caused by add() and remove()).
+
+		@param added - receives new pairs.
+		@param removed - receives pairs that no longer overlap.
+	*/
+	template<typename T>
+	void SweepAndPrune<T>::step(std::vector<Pair>& added, std::vector<Pair>& removed)
+	{
+		sortAxis(0);
+		sortAxis(1);
+		flush(added, removed);
+	}
+
+	/*
+		Recompute everything from scratch: full sort of both axes and a sweep along x.
+		Use after inserting many boxes at once or teleporting most of them, where the
+		incremental sort would do quadratic work. Events are the difference to the
+		previous pair set.
+
+		@param added - receives new pairs.
+		@param removed - receives pairs that no longer overlap.
+	*/
+	template<typename T>
+	void SweepAndPrune<T>::rebuild(std::vector<Pair>& added, std::vector<Pair>& removed)
+	{
+		for (int k = 0; k < 2; k++)
+		{
+			for (Endpoint& p : axes[k])
+				p.value = (p.id & 1) ? hi[k][p.id >> 1] : lo[k][p.id >> 1];
+			std::sort(axes[k].begin(), axes[k].end(), less);
+		}
+
+		//Boxes ordered by min x, with their bounds copied to contiguous arrays.
+		std::vector<Handle> order;
+		for (const Endpoint& p : axes[0])
+			if (!(p.id & 1))
+				order.push_back(p.id >> 1);
+		size_t n = order.size();
+		std::vector<T> minX(n), maxX(n), minY(n), maxY(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			minX[i] = lo[0][order[i]]; maxX[i] = hi[0][order[i]];
+			minY[i] = lo[1][order[i]]; maxY[i] = hi[1][order[i]];
+		}
+
+		std::unordered_set<uint64_t> next;
+		next.reserve(pairs.size());
+		constexpr size_t Chunk = 64;
+		uint8_t hit[Chunk];
+		for (size_t i = 0; i < n; i++)
+		{
+			//Candidates are the boxes starting before this one ends on x; their y
+			//overlap is tested in fixed-size chunks so the loop vectorizes.
+			size_t end = std::upper_bound(minX.begin() + i + 1, minX.end(), maxX[i]) - minX.begin();
+			for (size_t base = i + 1; base < end; base += Chunk)
+			{
+				size_t m = std::min(Chunk, end - base);
+				for (size_t j = 0; j < m; j++)
+					hit[j] = (minY[base + j] <= maxY[i]) & (minY[i] <= maxY[base + j]);
+				for (size_t j = 0; j < m; j++)
+					if (hit[j])
+						next.insert(key(order[i], order[base + j]));
+			}
+		}
+
+		for (uint64_t k : pairs)
+			if (!next.count(k))
+				record(k, false);
+		for (uint64_t k : next)
+			if (!pairs.count(k))
+				record(k, true);
+		pairs.swap(next);
+		flush(added, removed);
+	}
+
+	/*
+		Append the handles of all live boxes overlapping 'box'. Tests the bounds
+		arrays directly, so it also sees updates not yet applied by step().
+
+		@param box - query bounds.
+		@param out - receives the handles.
+	*/
+	template<typename T>
+	void SweepAndPrune<T>::query(const AABB2<T>& box, std::vector<Handle>& out) const
+	{
+		constexpr size_t Chunk = 64;
+		uint8_t hit[Chunk];
+		size_t n = alive.size();
+		for (size_t base = 0; base < n; base += Chunk)
+		{
+			size_t m = std::min(Chunk, n - base);
+			for (size_t j = 0; j < m; j++)
+			{
+				size_t h = base + j;
+				hit[j] = alive[h] & (lo[0][h] <= box.max.x) & (box.min.x <= hi[0][h]) & (lo[1][h] <= box.max.y) & (box.min.y <= hi[1][h]);
+			}
+			for (size_t j = 0; j < m; j++)
+				if (hit[j])
+					out.push_back(static_cast<Handle>(base + j));
+		}
+	}
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*
+		Array of two-dimensional vectors that remembers which parts were written since
+		the last reset, so consumers (bounds, spatial hashes, network diffs, uploads)
+		only revisit what changed.
+
+		Elements are grouped into blocks of BlockSize; one bit per block marks it dirty.
+		Each 64-bit word of the bitset carries the epoch it was last written in, and a
+		word from an older epoch reads as clean, so reset() is a single increment no
+		matter how large the array is.
+
+		Any mutable access marks its block: set(), modify() and resize(). Indexing is
+		read-only, so reads through get(), operator[] and view() never mark anything.
+	*/
+	template<typename T, size_t BlockSize = 64>
+	class TrackedVector2Array
+	{
+		static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two.");
+
+	public:
+		TrackedVector2Array() = default;
+		explicit TrackedVector2Array(size_t count, const Vector2<T>& value = Vector2<T>());
+
+		size_t                      size() const { return items.size(); }
+		const Vector2<T>&           get(size_t i) const { return items[i]; }
+		const Vector2<T>&           operator[](size_t i) const { return items[i]; }
+		std::span<const Vector2<T>> view() const { return items; }
+		std::span<Vector2<T>>       modify(size_t first, size_t count);
+
+		void     set(size_t i, const Vector2<T>& v);
+		void     set(size_t i, T x, T y);
+		void     resize(size_t count, const Vector2<T>& value = Vector2<T>());
+		void     markDirty(size_t first, size_t count);
+		void     markAllDirty() { markDirty(0, items.size()); }
+
+		bool     isDirty(size_t i) const;
+		bool     isClean() const;
+		size_t   getDirtyBlockCount() const;
+		uint64_t getEpoch() const { return epoch; }
+		uint64_t reset() { return ++epoch; }
+
+		template<typename F>
+		void     forEachDirty(F&& f) const;
+
+	private:
+		static constexpr size_t WordBits = 64;
+
+		uint64_t word(size_t w) const { return stamps[w] == epoch ? bits[w] : 0; }
+		void     markBlock(size_t b);
+
+		std::vector<Vector2<T>> items;
+		std::vector<uint64_t>   bits;
+		std::vector<uint64_t>   stamps;
+		uint64_t                epoch = 1;
+	};
+
+	/*
+		Create an array of 'count' copies of 'value'. All of it starts dirty so the
+		first pass of every consumer sees the initial contents.
+	*/
+	template<typename T, size_t BlockSize>
+	inline TrackedVector2Array<T, BlockSize>::TrackedVector2Array(size_t count, const Vector2<T>& value)
+	{
+		resize(count, value);
+	}
+
+	template<typename T, size_t BlockSize>
+	inline void TrackedVector2Array<T, BlockSize>::markBlock(size_t b)
+	{
+		size_t w = b / WordBits;
+		if (stamps[w] != epoch)
+		{
+			stamps[w] = epoch;
+			bits[w] = 0;
+		}
+		bits[w] |= uint64_t(1) << (b % WordBits);
+	}
+
+	/*
+		Return a writable range and mark every block it touches dirty. Use for bulk
+		updates through the batch kernels.
+
+		@param first - index of the first element.
+		@param count - number of elements.
+	*/
+	template<typename T, size_t BlockSize>
+	inline std::span<Vector2<T>> TrackedVector2Array<T, BlockSize>::modify(size_t first, size_t count)
+	{
+		markDirty(first, count);
+		return std::span<Vector2<T>>(items).subspan(first, count);
+	}
+
+	/*
+		Write element i and mark its block dirty.
+	*/
+	template<typename T, size_t BlockSize>
+	inline void TrackedVector2Array<T, BlockSize>::set(size_t i, const Vector2<T>& v)
+	{
+		assert(i < items.size());
+		markBlock(i / BlockSize);
+		items[i] = v;
+	}
+
+	/*
+		Write the components of element i and mark its block dirty.
+	*/
+	template<typename T, size_t BlockSize>
+	inline void TrackedVector2Array<T, BlockSize>::set(size_t i, T x, T y)
+	{
+		assert(i < items.size());
+		markBlock(i / BlockSize);
+		items[i].set(x, y);
+	}
+
+	/*
+		Change the number of elements. New elements are copies of 'value' and are
+		dirty. Shrinking drops the dirty state of the removed blocks.
+	*/
+	template<typename T, size_t BlockSize>
+	void TrackedVector2Array<T, BlockSize>::resize(size_t count, const Vector2<T>& value)
+	{
+		size_t old = items.size();
+		items.resize(count, value);
+		size_t words = ((count + BlockSize - 1) / BlockSize + WordBits - 1) / WordBits;
+		bits.resize(words, 0);
+		stamps.resize(words, 0);
+		if (count > old)
+			markDirty(old, count - old);
+		else if (size_t tail = (count + BlockSize - 1) / BlockSize % WordBits; tail && words)
+			bits[words - 1] &= (uint64_t(1) << tail) - 1;
+	}
+
+	/*
+		Mark a range dirty after writing it through a pointer obtained elsewhere.
+
+		@param first - index of the first element.
+		@param count - number of elements.
+	*/
+	template<typename T, size_t BlockSize>
+	void TrackedVector2Array<T, BlockSize>::markDirty(size_t first, size_t count)
+	{
+		assert(first + count <= items.size());
+		if (count == 0)
+			return;
+		size_t b = first / BlockSize, last = (first + count - 1) / BlockSize;
+		//Whole words at a time once the range is wide enough.
+		for (; b <= last && b % WordBits != 0; b++)
+			markBlock(b);
+		for (; b + WordBits - 1 <= last; b += WordBits)
+		{
+			stamps[b / WordBits] = epoch;
+			bits[b / WordBits] = ~uint64_t(0);
+		}
+		for (; b <= last; b++)
+			markBlock(b);
+	}
+
+	/*
+		Return true if the block holding element i was written this epoch.
+	*/
+	template<typename T, size_t BlockSize>
+	inline bool TrackedVector2Array<T, BlockSize>::isDirty(size_t i) const
+	{
+		size_t b = i / BlockSize;
+		return (word(b / WordBits) >> (b % WordBits)) & 1;
+	}
+
+	/*
+		Return true if nothing was written this epoch.
+	*/
+	template<typename T, size_t BlockSize>
+	bool TrackedVector2Array<T, BlockSize>::isClean() const
+	{
+		for (size_t w = 0; w < bits.size(); w++)
+			if (word(w))
+				return false;
+		return true;
+	}
+
+	/*
+		Return the number of dirty blocks.
+	*/
+	template<typename T, size_t BlockSize>
+	size_t TrackedVector2Array<T, BlockSize>::getDirtyBlockCount() const
+	{
+		size_t n = 0;
+		for (size_t w = 0; w < bits.size(); w++)
+			n += std::popcount(word(w));
+		return n;
+	}
+
+	/*
+		Call f(first, elements) for every run of consecutive dirty blocks, in order.
+		'elements' is a read-only span starting at index 'first'; runs are merged so
+		a contiguous dirty region arrives as one call.
+
+		@param f - callable taking (size_t, std::span<const Vector2<T>>).
+	*/
+	template<typename T, size_t BlockSize>
+	template<typename F>
+	void TrackedVector2Array<T, BlockSize>::forEachDirty(F&& f) const
+	{
+		std::span<const Vector2<T>> all(items);
+		size_t blocks = (items.size() + BlockSize - 1) / BlockSize;
+		size_t runStart = 0, runEnd = 0;
+		for (size_t w = 0; w < bits.size(); w++)
+		{
+			uint64_t m = word(w);
+			while (m)
+			{
+				size_t b = w * WordBits + std::countr_zero(m);
+				//Consume the run of set bits starting here within this word.
+				size_t len = std::countr_one(m >> (b % WordBits));
+				m &= len == WordBits ? 0 : ~(((uint64_t(1) << len) - 1) << (b % WordBits));
+
+				if (runEnd != b)
+				{
+					if (runEnd > runStart)
+						f(runStart * BlockSize, all.subspan(runStart * BlockSize, std::min(runEnd * BlockSize, items.size()) - runStart * BlockSize));
+					runStart = b;
+				}
+				runEnd = std::min(b + len, blocks);
+			}
+		}
+		if (runEnd > runStart)
+			f(runStart * BlockSize, all.subspan(runStart * BlockSize, std::min(runEnd * BlockSize, items.size()) - runStart * BlockSize));
+	}
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <limits>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*Represents an axis-aligned box in two dimensions.*/
+	template<typename T>
+	struct AABB2
+	{
+		/*The minimum and maximum corners of the box.*/
+		Vector2<T> min, max;
+
+		/*Creates a two-dimensional box.*/
+		AABB2() = default;
+		AABB2(const Vector2<T>& min, const Vector2<T>& max);
+
+		static AABB2<T> empty();
+		static AABB2<T> of(const Vector2<T>& a, const Vector2<T>& b);
+
+		AABB2<T>&  expand(const Vector2<T>& p);
+		AABB2<T>&  expand(const AABB2<T>& b);
+		bool       overlaps(const AABB2<T>& b) const;
+		bool       contains(const Vector2<T>& p) const;
+		bool       isEmpty() const;
+		Vector2<T> center() const;
+		Vector2<T> extent() const;
+		T          perimeter() const;
+	};
+
+	/*
+		Create a box from its two corners.
+
+		@param min, max - the minimum and maximum corners.
+	*/
+	template<typename T>
+	inline AABB2<T>::AABB2(const Vector2<T>& min, const Vector2<T>& max) : min(min), max(max) {}
+
+	/*
+		Return an inverted box that becomes the bounds of the first point or box it is
+		expanded with.
+	*/
+	template<typename T>
+	inline AABB2<T> AABB2<T>::empty()
+	{
+		return AABB2<T>(Vector2<T>(std::numeric_limits<T>::max()), Vector2<T>(std::numeric_limits<T>::lowest()));
+	}
+
+	/*
+		Return the bounds of two arbitrary points, e.g. the endpoints of a segment.
+	*/
+	template<typename T>
+	inline AABB2<T> AABB2<T>::of(const Vector2<T>& a, const Vector2<T>& b)
+	{
+		AABB2<T> r(a, a);
+		return r.expand(b);
+	}
+
+	/*
+		Grow the box to include p.
+	*/
+	template<typename T>
+	inline AABB2<T>& AABB2<T>::expand(const Vector2<T>& p)
+	{
+		min.min(p);
+		max.max(p);
+		return *this;
+	}
+
+	/*
+		Grow the box to include b.
+	*/
+	template<typename T>
+	inline AABB2<T>& AABB2<T>::expand(const AABB2<T>& b)
+	{
+		min.min(b.min);
+		max.max(b.max);
+		return *this;
+	}
+
+	/*
+		Return true if the boxes intersect or touch.
+	*/
+	template<typename T>
+	inline bool AABB2<T>::overlaps(const AABB2<T>& b) const
+	{
+		return min.x <= b.max.x && b.min.x <= max.x && min.y <= b.max.y && b.min.y <= max.y;
+	}
+
+	/*
+		Return true if p lies inside the box or on its boundary.
+	*/
+	template<typename T>
+	inline bool AABB2<T>::contains(const Vector2<T>& p) const
+	{
+		return min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y;
+	}
+
+	/*
+		Return true if the box contains no point.
+	*/
+	template<typename T>
+	inline bool AABB2<T>::isEmpty() const { return min.x > max.x || min.y > max.y; }
+
+	/*
+		Return the center of the box.
+	*/
+	template<typename T>
+	inline Vector2<T> AABB2<T>::center() const { return (min + max) / static_cast<T>(2); }
+
+	/*
+		Return the size of the box along each axis.
+	*/
+	template<typename T>
+	inline Vector2<T> AABB2<T>::extent() const { return max - min; }
+
+	/*
+		Return the perimeter of the box, the 2D analogue of the surface area used by
+		the surface area heuristic.
+	*/
+	template<typename T>
+	inline T AABB2<T>::perimeter() const { return static_cast<T>(2) * ((max.x - min.x) + (max.y - min.y)); }
+}
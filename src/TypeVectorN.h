@@ -0,0 +1,856 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <utility>
+
+#include "Simd.h"
+
+namespace Force::Math
+{
+	/*
+		Shared core of every vector type. The concrete vector (Vector2, VectorN...) owns
+		the storage and passes itself as D; all component-wise operations are written
+		once here over N components and unrolled at compile time.
+
+		D must store its N components contiguously and expose them through toPtr().
+	*/
+	template<typename D, typename T, uint32_t N>
+	struct VectorCore
+	{
+		using ValueType = T;
+		static constexpr uint32_t Size = N;
+
+		/*Call f(i) for every component index, unrolled at compile time.*/
+		template<typename F>
+		static constexpr void unroll(F&& f)
+		{
+			[&]<uint32_t... I>(std::integer_sequence<uint32_t, I...>) { (f(I), ...); }(std::make_integer_sequence<uint32_t, N>{});
+		}
+
+		constexpr T*       data() { return static_cast<D*>(this)->toPtr(); }
+		constexpr const T* data() const { return static_cast<const D*>(this)->toPtr(); }
+
+		//Operator-accessor
+		constexpr T&       operator[](uint32_t i) { assert(i < N); return data()[i]; }
+		constexpr const T& operator[](uint32_t i) const { assert(i < N); return data()[i]; }
+
+		//Compound assignment operators
+		D& operator+=(const D& v) { unroll([&](uint32_t i) { data()[i] += v[i]; }); return self(); }
+		D& operator-=(const D& v) { unroll([&](uint32_t i) { data()[i] -= v[i]; }); return self(); }
+		D& operator*=(const D& v) { unroll([&](uint32_t i) { data()[i] *= v[i]; }); return self(); }
+		D& operator/=(const D& v) { unroll([&](uint32_t i) { data()[i] /= v[i]; }); return self(); }
+		D& operator+=(T scalar) { unroll([&](uint32_t i) { data()[i] += scalar; }); return self(); }
+		D& operator-=(T scalar) { unroll([&](uint32_t i) { data()[i] -= scalar; }); return self(); }
+		D& operator*=(T scalar) { unroll([&](uint32_t i) { data()[i] *= scalar; }); return self(); }
+		D& operator/=(T scalar) { unroll([&](uint32_t i) { data()[i] /= scalar; }); return self(); }
+
+		static T dot(const D& a, const D& b);
+		T        dot(const D& v) const;
+		T        square() const;
+		T        square(const D& v) const;
+		T        length() const;
+		T        length(const D& v) const;
+		static T distance(const D& v1, const D& v2);
+		T        distance(const D& v) const;
+		static T distanceSquared(const D& v1, const D& v2);
+		T        distanceSquared(const D& v) const;
+		void     normalize();
+		D&       normalize(D& dest) const;
+		void     normalize(T length);
+		D&       normalize(T length, D& dest) const;
+		D&       negate();
+		D&       negate(D& dest) const;
+		D&       lerp(const D& other, T factor);
+		D&       lerp(const D& other, T factor, D& dest) const;
+		D&       fma(T a, const D& b);
+		D&       fma(T a, const D& b, D& dest) const;
+		D&       fma(const D& a, const D& b, D& dest) const;
+		int      min() const;
+		D&       min(const D& v);
+		D&       min(const D& v, D& dest) const;
+		int      max() const;
+		D&       max(const D& v);
+		D&       max(const D& v, D& dest) const;
+		D&       floor();
+		D&       floor(D& dest) const;
+		D&       ceil();
+		D&       ceil(D& dest) const;
+		D&       round();
+		D&       round(D& dest) const;
+		D&       absolute();
+		D&       absolute(D& dest) const;
+		D&       zero();
+		D&       one();
+
+		D&       set(T v);
+		D&       set(const T* varr);
+		D&       set(uint32_t comp, T v);
+		D&       set(const D& other);
+		D&       set(D&& other);
+		T        get(uint32_t comp) const;
+
+	private:
+		constexpr D&       self() { return static_cast<D&>(*this); }
+		constexpr const D& self() const { return static_cast<const D&>(*this); }
+
+		//Write f(i) into every component of dest and return dest.
+		template<typename F>
+		static D& apply(D& dest, F&& f)
+		{
+			T r[N];
+			unroll([&](uint32_t i) { r[i] = f(i); });
+			unroll([&](uint32_t i) { dest[i] = r[i]; });
+			return dest;
+		}
+	};
+
+	/*Represents a vector of N components of type T.*/
+	template<typename T, uint32_t N>
+	struct VectorN : VectorCore<VectorN<T, N>, T, N>
+	{
+		using Core = VectorCore<VectorN<T, N>, T, N>;
+
+		/*The components of the vector.*/
+		T v[N];
+
+		VectorN() = default;
+		VectorN(T scalar) { Core::unroll([&](uint32_t i) { v[i] = scalar; }); }
+		VectorN(const T* varr) { Core::unroll([&](uint32_t i) { v[i] = varr[i]; }); }
+		template<typename... A, typename = std::enable_if_t<sizeof...(A) == N && (N > 1)>>
+		VectorN(A... c) : v{ static_cast<T>(c)... } {}
+
+		constexpr T*       toPtr() { return v; }
+		constexpr const T* toPtr() const { return v; }
+	};
+
+	// +=+=+=+=+=+= Arithmetic binary operations (+, -, /, *) +=+=+=+=+=+=+=
+
+	/*
+		Build a new D from f(i) for every component. Used by all the binary operators
+		below so each operator stays a one-liner.
+	*/
+	template<typename D, typename T, uint32_t N, typename F>
+	inline D makeVector(F&& f)
+	{
+		D r;
+		VectorCore<D, T, N>::unroll([&](uint32_t i) { r[i] = static_cast<T>(f(i)); });
+		return r;
+	}
+
+	template<typename D, typename T, uint32_t N>
+	inline T operator+(const VectorCore<D, T, N>& v) { return v[0]; } //Gets the first vector value.
+
+	template<typename D, typename T, uint32_t N>
+	inline D operator-(const VectorCore<D, T, N>& v) { //Inverse the vector values.
+		return makeVector<D, T, N>([&](uint32_t i) { return -v[i]; });
+	}
+
+#define FORCEML_VECTOR_BINARY_OP(op)                                                                               \
+	template<typename D, typename T, uint32_t N>                                                                   \
+	inline D operator op(const VectorCore<D, T, N>& a, const VectorCore<D, T, N>& b) {                             \
+		return makeVector<D, T, N>([&](uint32_t i) { return a[i] op b[i]; });                                      \
+	}                                                                                                              \
+	template<typename D, typename T, uint32_t N>                                                                   \
+	inline D operator op(const VectorCore<D, T, N>& v, T scalar) {                                                 \
+		return makeVector<D, T, N>([&](uint32_t i) { return v[i] op scalar; });                                    \
+	}                                                                                                              \
+	template<typename D, typename T, uint32_t N>                                                                   \
+	inline D operator op(T scalar, const VectorCore<D, T, N>& v) {                                                 \
+		return makeVector<D, T, N>([&](uint32_t i) { return scalar op v[i]; });                                    \
+	}
+
+	FORCEML_VECTOR_BINARY_OP(+)
+	FORCEML_VECTOR_BINARY_OP(-)
+	FORCEML_VECTOR_BINARY_OP(*)
+	FORCEML_VECTOR_BINARY_OP(/)
+
+	// +=+=+=+=+=+= Other binary operations (&, ^, |, <<, >>, ~) +=+=+=+=+=+=+=
+
+	template<typename D, typename T, uint32_t N>
+	inline D operator~(const VectorCore<D, T, N>& v) {
+		return makeVector<D, T, N>([&](uint32_t i) { return ~v[i]; });
+	}
+
+	FORCEML_VECTOR_BINARY_OP(&)
+	FORCEML_VECTOR_BINARY_OP(^)
+	FORCEML_VECTOR_BINARY_OP(|)
+	FORCEML_VECTOR_BINARY_OP(<<)
+	FORCEML_VECTOR_BINARY_OP(>>)
+
+#undef FORCEML_VECTOR_BINARY_OP
+
+	// +=+=+=+=+=+= Boolean operations (&&, ||, !=, ==, >, <) +=+=+=+=+=+=+=
+
+	/*Return true when pred(i) holds for every component.*/
+	template<typename D, typename T, uint32_t N, typename F>
+	inline bool allOf(F&& pred)
+	{
+		bool r = true;
+		VectorCore<D, T, N>::unroll([&](uint32_t i) { r = r && pred(i); });
+		return r;
+	}
+
+	template<typename D, typename T, uint32_t N>
+	inline bool operator>(const VectorCore<D, T, N>& a, const VectorCore<D, T, N>& b) {
+		return allOf<D, T, N>([&](uint32_t i) { return a[i] > b[i]; });
+	}
+	template<typename D, typename T, uint32_t N>
+	inline bool operator>(const VectorCore<D, T, N>& a, T scalar) {
+		return allOf<D, T, N>([&](uint32_t i) { return a[i] > scalar; });
+	}
+	template<typename D, typename T, uint32_t N>
+	inline bool operator>(T scalar, const VectorCore<D, T, N>& v) {
+		return allOf<D, T, N>([&](uint32_t i) { return scalar > v[i]; });
+	}
+
+	template<typename D, typename T, uint32_t N>
+	inline bool operator<(const VectorCore<D, T, N>& a, const VectorCore<D, T, N>& b) {
+		return allOf<D, T, N>([&](uint32_t i) { return a[i] < b[i]; });
+	}
+	template<typename D, typename T, uint32_t N>
+	inline bool operator<(const VectorCore<D, T, N>& a, T scalar) {
+		return allOf<D, T, N>([&](uint32_t i) { return a[i] < scalar; });
+	}
+	template<typename D, typename T, uint32_t N>
+	inline bool operator<(T scalar, const VectorCore<D, T, N>& v) {
+		return allOf<D, T, N>([&](uint32_t i) { return scalar < v[i]; });
+	}
+
+	template<typename D, typename T, uint32_t N>
+	inline bool operator==(const VectorCore<D, T, N>& a, const VectorCore<D, T, N>& b) {
+		return allOf<D, T, N>([&](uint32_t i) { return a[i] == b[i]; });
+	}
+	template<typename D, typename T, uint32_t N>
+	inline bool operator!=(const VectorCore<D, T, N>& a, const VectorCore<D, T, N>& b) { return !(a == b); }
+	template<typename D, typename T, uint32_t N>
+	inline bool operator||(const VectorCore<D, T, N>& a, const VectorCore<D, T, N>& b) {
+		return !allOf<D, T, N>([&](uint32_t i) { return a[i] != b[i]; });
+	}
+	template<typename D, typename T, uint32_t N>
+	inline bool operator&&(const VectorCore<D, T, N>& a, const VectorCore<D, T, N>& b) { return a == b; }
+
+	// Print vector data to output stream.
+	template<typename T, uint32_t N>
+	inline std::ostream& operator<<(std::ostream& os, const VectorN<T, N>& v)
+	{
+		os << "(";
+		for (uint32_t i = 0; i < N; i++)
+			os << (i ? ", " : "") << v[i];
+		return os << ")";
+	}
+
+	/*
+		Return the dot product of two vectors i.e, x[0] * y[0] + x[1] * y[1]... .
+
+		@param a, b - vectors to calculate.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::dot(const D& a, const D& b)
+	{
+		T r = 0;
+		unroll([&](uint32_t i) { r += a[i] * b[i]; });
+		return r;
+	}
+
+	/*
+		Return the dot product of this and v.
+
+		@param v - vector to calculate.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::dot(const D& v) const { return dot(self(), v); }
+
+	/*
+		Return square representation value from this vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::square() const { return dot(self(), self()); }
+
+	/*
+		Return square representation value from v vector values.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::square(const D& v) const { return dot(v, v); }
+
+	/*
+		Return the length of this vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::length() const { return (T)Math::sqrt(square()); }
+
+	/*
+		Return the length of v, independent of this vector. Vector2 used to return
+		sqrt(dot(v)) here; write that out where it is meant.
+
+		@param v - the vector to measure.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::length(const D& v) const { return (T)Math::sqrt(dot(v, v)); }
+
+	/*
+		Return the distance between v1 and v2.
+
+		@param v1 - the first vector.
+		@param v2 - the second vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::distance(const D& v1, const D& v2) { return (T)Math::sqrt(distanceSquared(v1, v2)); }
+
+	/*
+		Return distance beetwen this vector and v.
+
+		@param v - the other vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::distance(const D& v) const { return distance(self(), v); }
+
+	/*
+		Return the squared distance between v1 and v2.
+
+		@param v1 - the first vector.
+		@param v2 - the second vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::distanceSquared(const D& v1, const D& v2)
+	{
+		T r = 0;
+		unroll([&](uint32_t i) { T d = v1[i] - v2[i]; r += d * d; });
+		return r;
+	}
+
+	/*
+		Return distance squared beetwen this vector and v.
+
+		@param v - the other vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::distanceSquared(const D& v) const { return distanceSquared(self(), v); }
+
+	/*
+		Normalize this vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline void VectorCore<D, T, N>::normalize() { normalize(self()); }
+
+	/*
+		Normalize this vector and store the result in dest.
+
+		@param dest - vector to receive the result.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::normalize(D& dest) const
+	{
+		T invLength = Math::invsqrt(square());
+		return apply(dest, [&](uint32_t i) { return data()[i] * invLength; });
+	}
+
+	/*
+		Normalized vector and scale it to have the given length.
+
+		@param length - length to scale.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline void VectorCore<D, T, N>::normalize(T length) { normalize(length, self()); }
+
+	/*
+		Normalized vector, scale it to have the given length and store it in dest.
+
+		@param length - length to scale.
+		@param dest - vector to receive the result.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::normalize(T length, D& dest) const
+	{
+		T invLength = Math::invsqrt(square()) * length;
+		return apply(dest, [&](uint32_t i) { return data()[i] * invLength; });
+	}
+
+	/*
+		Negate this vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::negate() { return negate(self()); }
+
+	/*
+		Negate this vector and store the result in dest.
+
+		@param dest - vector to receive the result.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::negate(D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return -data()[i]; });
+	}
+
+	/*
+		Linearly interpolate this and 'other' using the given interpolation factor 'factor'
+		and store the result in this.
+
+		If 'factor' is 0 then the result is this. If the interpolation factor is 1
+		then the result is other.
+
+		@param other - vector to calculate.
+		@param factor - the interpolation factor between 0 and 1.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::lerp(const D& other, T factor) { return lerp(other, factor, self()); }
+
+	/*
+		Version with dest of lerp(const D& other, T factor).
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::lerp(const D& other, T factor, D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return data()[i] + (other[i] - data()[i]) * factor; });
+	}
+
+	/*
+		Add the multiplication of a * b to this vector.
+
+		@param a - the scalar multiplicand
+		@param b - the vector multiplicand
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::fma(T a, const D& b) { return fma(a, b, self()); }
+
+	/*
+		Add the multiplication of a * b to this vector and store the result in dest.
+
+		@param a - the scalar multiplicand
+		@param b - the vector multiplicand
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::fma(T a, const D& b, D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return data()[i] + a * b[i]; });
+	}
+
+	/*
+		Add the component-wise multiplication of a * b to this vector and store the
+		result in dest.
+
+		@param a - the first multiplicand
+		@param b - the second multiplicand
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::fma(const D& a, const D& b, D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return data()[i] + a[i] * b[i]; });
+	}
+
+	/*
+		Return the index of the component with the smallest absolute value.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline int VectorCore<D, T, N>::min() const
+	{
+		int r = 0;
+		for (uint32_t i = 1; i < N; i++)
+			if (!(Math::abs(data()[r]) < Math::abs(data()[i]))) r = i;
+		return r;
+	}
+
+	/*
+		Set the components of this vector to be the component-wise minimum of
+		this and the other vector.
+
+		@param v - the other vector
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::min(const D& v) { return min(v, self()); }
+
+	/*
+		Store the component-wise minimum of this and the other vector in dest.
+
+		@param v - the other vector
+		@param dest - destanation vector
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::min(const D& v, D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return data()[i] < v[i] ? data()[i] : v[i]; });
+	}
+
+	/*
+		Return the index of the component with the largest absolute value.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline int VectorCore<D, T, N>::max() const
+	{
+		int r = 0;
+		for (uint32_t i = 1; i < N; i++)
+			if (!(Math::abs(data()[r]) >= Math::abs(data()[i]))) r = i;
+		return r;
+	}
+
+	/*
+		Set the components of this vector to be the component-wise maximum of
+		this and the other vector.
+
+		@param v - the other vector
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::max(const D& v) { return max(v, self()); }
+
+	/*
+		Store the component-wise maximum of this and the other vector in dest.
+
+		@param v - the other vector
+		@param dest - destanation vector
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::max(const D& v, D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return data()[i] > v[i] ? data()[i] : v[i]; });
+	}
+
+	/*
+		Set each component of this vector to the largest (closest to positive
+		infinity) value that is less than or equal to that component and is
+		equal to a mathematical integer.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::floor() { return floor(self()); }
+
+	/*
+		Dest version of floor().
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::floor(D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return Math::floor(data()[i]); });
+	}
+
+	/*
+		Ceil each component of this vector.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::ceil() { return ceil(self()); }
+
+	/*
+		Dest version of ceil().
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::ceil(D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return Math::ceil(data()[i]); });
+	}
+
+	/*
+		Set each component of this vector to the closest float that is equal to
+		a mathematical integer, with ties rounding to positive infinity.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::round() { return round(self()); }
+
+	/*
+		Dest version of round().
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::round(D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return Math::round(data()[i]); });
+	}
+
+	/*
+		Set this vector's components to their respective absolute values.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::absolute() { return absolute(self()); }
+
+	/*
+		Dest version of absolute().
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::absolute(D& dest) const
+	{
+		return apply(dest, [&](uint32_t i) { return Math::abs(data()[i]); });
+	}
+
+	/*
+		Reset this vector to zero.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::zero() { return set(static_cast<T>(0)); }
+
+	/*
+		Reset this vector to one.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::one() { return set(static_cast<T>(1)); }
+
+	/*
+		Set every component to the supplied value.
+		@param v - the value of all components.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::set(T v)
+	{
+		unroll([&](uint32_t i) { data()[i] = v; });
+		return self();
+	}
+
+	/*
+		Set the components from the first N elements of the given array.
+		@param varr - the array containing at least N elements
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::set(const T* varr)
+	{
+		unroll([&](uint32_t i) { data()[i] = varr[i]; });
+		return self();
+	}
+
+	/*
+		Set a single component of this vector. Out of range indices are ignored.
+		@param comp - index of the component.
+		@param v - value to set.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::set(uint32_t comp, T v)
+	{
+		if (comp < N) data()[comp] = v;
+		return self();
+	}
+
+	/*
+		Copy all components from other.
+		@param other - vector to copy the values from.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::set(const D& other) { return set(other.toPtr()); }
+
+	template<typename D, typename T, uint32_t N>
+	inline D& VectorCore<D, T, N>::set(D&& other)
+	{
+		unroll([&](uint32_t i) { data()[i] = std::move(other[i]); });
+		return self();
+	}
+
+	/*
+		Return the value of a component, or zero when out of range.
+
+		@param comp - index of the component.
+	*/
+	template<typename D, typename T, uint32_t N>
+	inline T VectorCore<D, T, N>::get(uint32_t comp) const { return comp < N ? data()[comp] : 0; }
+
+	/*
+		Batch kernels over spans of any vector type built on VectorCore. The vectors
+		are processed as one flat array of components through the Simd backend, so
+		every kernel works for all widths without per-type code.
+	*/
+	template<typename V>
+	struct VectorBatch
+	{
+		using T = typename V::ValueType;
+		static constexpr uint32_t N = V::Size;
+		static_assert(sizeof(V) == sizeof(T) * N, "Vector components must be tightly packed.");
+
+		static void add(std::span<V> dst, std::span<const V> a, std::span<const V> b);
+		static void sub(std::span<V> dst, std::span<const V> a, std::span<const V> b);
+		static void mul(std::span<V> dst, std::span<const V> a, std::span<const V> b);
+		static void div(std::span<V> dst, std::span<const V> a, std::span<const V> b);
+		static void min(std::span<V> dst, std::span<const V> a, std::span<const V> b);
+		static void max(std::span<V> dst, std::span<const V> a, std::span<const V> b);
+		static void scale(std::span<V> dst, std::span<const V> a, T s);
+		static void fma(std::span<V> dst, std::span<const V> a, T s, std::span<const V> b);
+		static void lerp(std::span<V> dst, std::span<const V> a, std::span<const V> b, T factor);
+		static void normalize(std::span<V> dst, std::span<const V> a);
+		static void dot(std::span<T> dst, std::span<const V> a, std::span<const V> b);
+
+		static T*       flat(std::span<V> v) { return reinterpret_cast<T*>(v.data()); }
+		static const T* flat(std::span<const V> v) { return reinterpret_cast<const T*>(v.data()); }
+
+	private:
+		template<typename P>
+		static void loadComponents(const T* p, P (&out)[N]);
+	};
+
+	/*
+		dst[i] = a[i] + b[i].
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::add(std::span<V> dst, std::span<const V> a, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [](auto x, auto y) { return x + y; }, flat(a), flat(b));
+	}
+
+	/*
+		dst[i] = a[i] - b[i].
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::sub(std::span<V> dst, std::span<const V> a, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [](auto x, auto y) { return x - y; }, flat(a), flat(b));
+	}
+
+	/*
+		dst[i] = a[i] * b[i], component-wise.
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::mul(std::span<V> dst, std::span<const V> a, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [](auto x, auto y) { return x * y; }, flat(a), flat(b));
+	}
+
+	/*
+		dst[i] = a[i] / b[i], component-wise.
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::div(std::span<V> dst, std::span<const V> a, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [](auto x, auto y) { return x / y; }, flat(a), flat(b));
+	}
+
+	/*
+		dst[i] = component-wise minimum of a[i] and b[i].
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::min(std::span<V> dst, std::span<const V> a, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [](auto x, auto y) { return Simd::min(x, y); }, flat(a), flat(b));
+	}
+
+	/*
+		dst[i] = component-wise maximum of a[i] and b[i].
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::max(std::span<V> dst, std::span<const V> a, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [](auto x, auto y) { return Simd::max(x, y); }, flat(a), flat(b));
+	}
+
+	/*
+		dst[i] = a[i] * s.
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::scale(std::span<V> dst, std::span<const V> a, T s)
+	{
+		assert(dst.size() == a.size());
+		Simd::transform(flat(dst), dst.size() * N, [s](auto x) { return x * decltype(x)::broadcast(s); }, flat(a));
+	}
+
+	/*
+		dst[i] = a[i] * s + b[i].
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::fma(std::span<V> dst, std::span<const V> a, T s, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [s](auto x, auto y) { return Simd::fma(x, decltype(x)::broadcast(s), y); }, flat(a), flat(b));
+	}
+
+	/*
+		dst[i] = a[i] + (b[i] - a[i]) * factor.
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::lerp(std::span<V> dst, std::span<const V> a, std::span<const V> b, T factor)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		Simd::transform(flat(dst), dst.size() * N, [factor](auto x, auto y) { return Simd::fma(y - x, decltype(x)::broadcast(factor), x); }, flat(a), flat(b));
+	}
+
+	/*
+		Load component-major registers for P::Width consecutive vectors starting at p:
+		out[c] holds component c of each. Pairs are split with one shuffle, other
+		widths use a stride-N gather.
+	*/
+	template<typename V>
+	template<typename P>
+	inline void VectorBatch<V>::loadComponents(const T* p, P (&out)[N])
+	{
+		if constexpr (N == 2)
+			Simd::deinterleave(P::load(p), P::load(p + P::Width), out[0], out[1]);
+		else
+		{
+			int32_t index[P::Width];
+			for (uint32_t k = 0; k < P::Width; k++)
+				index[k] = static_cast<int32_t>(k * N);
+			for (uint32_t c = 0; c < N; c++)
+				out[c] = P::gather(p + c, index);
+		}
+	}
+
+	/*
+		dst[i] = a[i] / |a[i]|.
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::normalize(std::span<V> dst, std::span<const V> a)
+	{
+		assert(dst.size() == a.size());
+		const T* src = flat(a);
+		T* out = flat(dst);
+		auto kernel = [&](auto p, size_t i)
+		{
+			using P = decltype(p);
+			P c[N];
+			loadComponents(src + i * N, c);
+			P square = c[0] * c[0];
+			for (uint32_t k = 1; k < N; k++)
+				square = Simd::fma(c[k], c[k], square);
+			P inv = P::broadcast(static_cast<T>(1)) / Simd::sqrt(square);
+			if constexpr (N == 2)
+			{
+				P lo, hi;
+				Simd::interleave(c[0] * inv, c[1] * inv, lo, hi);
+				lo.store(out + i * N);
+				hi.store(out + i * N + P::Width);
+			}
+			else
+			{
+				T scale[P::Width];
+				inv.store(scale);
+				for (size_t k = 0; k < P::Width; k++)
+					for (uint32_t j = 0; j < N; j++)
+						out[(i + k) * N + j] = src[(i + k) * N + j] * scale[k];
+			}
+		};
+
+		using P = Simd::Pack<T>;
+		size_t i = 0;
+		for (; i + P::Width <= a.size(); i += P::Width)
+			kernel(P(), i);
+		for (; i < a.size(); i++)
+			kernel(Simd::Scalar<T>(), i);
+	}
+
+	/*
+		dst[i] = dot(a[i], b[i]).
+	*/
+	template<typename V>
+	inline void VectorBatch<V>::dot(std::span<T> dst, std::span<const V> a, std::span<const V> b)
+	{
+		assert(dst.size() == a.size() && dst.size() == b.size());
+		const T* pa = flat(a);
+		const T* pb = flat(b);
+		auto kernel = [&](auto p, size_t i)
+		{
+			using P = decltype(p);
+			P ca[N], cb[N];
+			loadComponents(pa + i * N, ca);
+			loadComponents(pb + i * N, cb);
+			P sum = ca[0] * cb[0];
+			for (uint32_t k = 1; k < N; k++)
+				sum = Simd::fma(ca[k], cb[k], sum);
+			sum.store(dst.data() + i);
+		};
+
+		using P = Simd::Pack<T>;
+		size_t i = 0;
+		for (; i + P::Width <= a.size(); i += P::Width)
+			kernel(P(), i);
+		for (; i < a.size(); i++)
+			kernel(Simd::Scalar<T>(), i);
+	}
+}
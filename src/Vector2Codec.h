@@ -0,0 +1,433 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <span>
+#include <vector>
+#include <type_traits>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*
+		Prediction used to turn consecutive quantized samples into small residuals.
+		Delta predicts the previous sample, Linear extrapolates the last two samples
+		(constant velocity) and is the better choice for smooth trajectories.
+	*/
+	enum class Vector2Predictor : uint8_t
+	{
+		Delta = 0,
+		Linear = 1
+	};
+
+	/*
+		Stream layout shared by Vector2Encoder and Vector2Decoder:
+
+		  header : precision as IEEE double (8 bytes, little endian), predictor (1 byte)
+		  block  : sample count - 1 (1 byte), bit width of the x residuals and of the
+		           y residuals (1 byte each), then the x residuals packed at their
+		           width, least significant bit first and padded to a byte, then the
+		           y residuals in the same way
+
+		Residuals are zigzag encoded so small negative values stay small, and every
+		block of up to BlockSize samples stores each component at the width of its
+		largest residual: a stationary component costs nothing and a smooth one a few
+		bits per sample. Samples are quantized to integers of 'precision' units, so the
+		reconstruction error of every component is at most precision / 2.
+	*/
+	namespace Codec
+	{
+		static constexpr size_t HeaderSize = 9;
+		static constexpr size_t BlockHeaderSize = 3;
+		static constexpr size_t BlockSize = 256;
+
+		inline uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+		inline int64_t  unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+		inline size_t packedSize(size_t n, uint32_t width) { return (n * width + 7) / 8; }
+
+		/*
+			Append n values of 'width' bits each (at most 64), least significant bit first.
+		*/
+		inline void packBits(std::vector<uint8_t>& out, const uint64_t* v, size_t n, uint32_t width)
+		{
+			size_t at = out.size();
+			out.resize(at + packedSize(n, width));
+			uint8_t* p = out.data() + at;
+			uint64_t acc = 0;
+			uint32_t fill = 0;
+			//Fewer than 8 bits are pending between calls, so 32 more always fit.
+			auto put = [&](uint64_t bits, uint32_t w)
+			{
+				acc |= bits << fill;
+				fill += w;
+				for (; fill >= 8; fill -= 8, acc >>= 8)
+					*p++ = static_cast<uint8_t>(acc);
+			};
+			for (size_t i = 0; i < n && width; i++)
+			{
+				if (width > 32)
+				{
+					put(v[i] & 0xFFFFFFFFu, 32);
+					put(v[i] >> 32, width - 32);
+				}
+				else
+					put(v[i], width);
+			}
+			if (fill)
+				*p = static_cast<uint8_t>(acc);
+		}
+
+		inline uint64_t load64(const uint8_t* p)
+		{
+			uint64_t v;
+			if constexpr (std::endian::native == std::endian::little)
+				std::memcpy(&v, p, sizeof(v));
+			else
+			{
+				v = 0;
+				for (int i = 0; i < 8; i++)
+					v |= static_cast<uint64_t>(p[i]) << (8 * i);
+			}
+			return v;
+		}
+
+		/*
+			Extract n values of 'width' bits written by packBits(). Every value is one
+			unaligned 64-bit load, a shift and a mask with no dependency on the previous
+			one, so the loop vectorizes. 'in' must be readable for 8 bytes past the
+			packed data.
+		*/
+		inline void unpackBits(const uint8_t* in, size_t n, uint32_t width, uint64_t* v)
+		{
+			if (width <= 56)
+			{
+				uint64_t mask = width ? ~uint64_t(0) >> (64 - width) : 0;
+				for (size_t i = 0; i < n; i++)
+				{
+					size_t bit = i * width;
+					v[i] = (load64(in + bit / 8) >> (bit % 8)) & mask;
+				}
+				return;
+			}
+			uint64_t high = ~uint64_t(0) >> (96 - width);
+			for (size_t i = 0; i < n; i++)
+			{
+				size_t bit = i * width, upper = bit + 32;
+				v[i] = ((load64(in + bit / 8) >> (bit % 8)) & 0xFFFFFFFFu) | (((load64(in + upper / 8) >> (upper % 8)) & high) << 32);
+			}
+		}
+
+		/*
+			Prediction and residuals use wrapping 64-bit arithmetic: the decoder undoes
+			exactly what the encoder did even when extrapolating far-apart samples
+			overflows.
+		*/
+		inline uint64_t predict(Vector2Predictor predictor, int64_t p1, int64_t p2)
+		{
+			uint64_t a = static_cast<uint64_t>(p1), b = static_cast<uint64_t>(p2);
+			return predictor == Vector2Predictor::Linear ? 2 * a - b : a;
+		}
+	}
+
+	/*
+		Incremental encoder for sequences of two-dimensional vectors. Samples may be
+		pushed one at a time or in spans. They are encoded a block at a time: data()
+		holds the complete blocks, and flush() or take() closes a partial one.
+	*/
+	template<typename T>
+	class Vector2Encoder
+	{
+		static_assert(std::is_floating_point_v<T>, "Vector2Encoder requires a floating point component type.");
+
+	public:
+		Vector2Encoder(T precision, Vector2Predictor predictor = Vector2Predictor::Linear);
+
+		void                     push(const Vector2<T>& v);
+		void                     push(std::span<const Vector2<T>> samples);
+		void                     flush();
+		std::span<const uint8_t> data() const { return bytes; }
+		std::vector<uint8_t>     take();
+		uint64_t                 count() const { return samples; }
+
+	private:
+		void encode(int64_t qx, int64_t qy);
+
+		T                    invPrecision;
+		Vector2Predictor     predictor;
+		int64_t              prev[2][2] = {};
+		uint64_t             samples = 0;
+		size_t               pending = 0;
+		int64_t              block[2][Codec::BlockSize];
+		std::vector<uint8_t> bytes;
+	};
+
+	/*
+		Incremental decoder. Bytes may arrive in arbitrary pieces through feed();
+		decode() returns only samples whose block is complete.
+	*/
+	template<typename T>
+	class Vector2Decoder
+	{
+		static_assert(std::is_floating_point_v<T>, "Vector2Decoder requires a floating point component type.");
+
+	public:
+		Vector2Decoder() = default;
+
+		void     feed(std::span<const uint8_t> data);
+		size_t   decode(std::span<Vector2<T>> out);
+		uint64_t count() const { return samples; }
+
+	private:
+		bool readHeader();
+		bool readBlock();
+
+		T                    precision = 0;
+		Vector2Predictor     predictor = Vector2Predictor::Delta;
+		bool                 hasHeader = false;
+		int64_t              prev[2][2] = {};
+		uint64_t             samples = 0;
+		size_t               offset = 0;
+		std::vector<uint8_t> bytes;
+		T                    decoded[Codec::BlockSize * 2];
+		size_t               blockCount = 0, blockPos = 0;
+	};
+
+	/*
+		Create an encoder and write the stream header.
+
+		@param precision - quantization step, e.g. 0.001 for millimetres in metre units.
+		@param predictor - prediction applied before encoding residuals.
+	*/
+	template<typename T>
+	Vector2Encoder<T>::Vector2Encoder(T precision, Vector2Predictor predictor)
+		: invPrecision(static_cast<T>(1) / precision), predictor(predictor)
+	{
+		double p = static_cast<double>(precision);
+		uint64_t raw;
+		std::memcpy(&raw, &p, sizeof(raw));
+		for (int i = 0; i < 8; i++)
+			bytes.push_back(static_cast<uint8_t>(raw >> (8 * i)));
+		bytes.push_back(static_cast<uint8_t>(predictor));
+	}
+
+	template<typename T>
+	inline void Vector2Encoder<T>::encode(int64_t qx, int64_t qy)
+	{
+		block[0][pending] = qx;
+		block[1][pending] = qy;
+		samples++;
+		if (++pending == Codec::BlockSize)
+			flush();
+	}
+
+	/*
+		Encode the samples pushed since the last complete block as a shorter block.
+		Call when the bytes must go out before a block fills, e.g. at the end of a
+		network tick; prefer full blocks where latency allows.
+	*/
+	template<typename T>
+	void Vector2Encoder<T>::flush()
+	{
+		if (pending == 0)
+			return;
+		uint64_t residuals[2][Codec::BlockSize];
+		uint32_t width[2];
+		for (int c = 0; c < 2; c++)
+		{
+			uint64_t all = 0;
+			for (size_t i = 0; i < pending; i++)
+			{
+				residuals[c][i] = Codec::zigzag(static_cast<int64_t>(static_cast<uint64_t>(block[c][i]) - Codec::predict(predictor, prev[c][0], prev[c][1])));
+				all |= residuals[c][i];
+				prev[c][1] = prev[c][0];
+				prev[c][0] = block[c][i];
+			}
+			width[c] = static_cast<uint32_t>(std::bit_width(all));
+		}
+		bytes.push_back(static_cast<uint8_t>(pending - 1));
+		bytes.push_back(static_cast<uint8_t>(width[0]));
+		bytes.push_back(static_cast<uint8_t>(width[1]));
+		for (int c = 0; c < 2; c++)
+			Codec::packBits(bytes, residuals[c], pending, width[c]);
+		pending = 0;
+	}
+
+	/*
+		Append a single sample to the stream.
+	*/
+	template<typename T>
+	void Vector2Encoder<T>::push(const Vector2<T>& v)
+	{
+		encode(std::llround(v.x * invPrecision), std::llround(v.y * invPrecision));
+	}
+
+	/*
+		Append a span of samples to the stream. Quantization runs over blocks of
+		components so it vectorizes; only the residual coding is sequential.
+	*/
+	template<typename T>
+	void Vector2Encoder<T>::push(std::span<const Vector2<T>> v)
+	{
+		T scaled[Codec::BlockSize * 2];
+		const T* flat = VectorBatch<Vector2<T>>::flat(v);
+		T s = invPrecision;
+		for (size_t base = 0; base < v.size(); base += Codec::BlockSize)
+		{
+			size_t n = v.size() - base < Codec::BlockSize ? v.size() - base : Codec::BlockSize;
+			Simd::transform(scaled, n * 2, [s](auto a) { return a * decltype(a)::broadcast(s); }, flat + base * 2);
+			for (size_t i = 0; i < n; i++)
+				encode(std::llround(scaled[2 * i]), std::llround(scaled[2 * i + 1]));
+		}
+	}
+
+	/*
+		Flush, then return the bytes encoded so far and clear the internal buffer.
+		Prediction state is kept, so the next bytes continue the same stream.
+	*/
+	template<typename T>
+	std::vector<uint8_t> Vector2Encoder<T>::take()
+	{
+		flush();
+		std::vector<uint8_t> out;
+		out.swap(bytes);
+		return out;
+	}
+
+	/*
+		Append encoded bytes to the decoder input.
+	*/
+	template<typename T>
+	void Vector2Decoder<T>::feed(std::span<const uint8_t> data)
+	{
+		if (offset > 0 && offset * 2 >= bytes.size())
+		{
+			bytes.erase(bytes.begin(), bytes.begin() + offset);
+			offset = 0;
+		}
+		bytes.insert(bytes.end(), data.begin(), data.end());
+	}
+
+	/*
+		Read the stream header. Return false if it is not complete yet or names an
+		unknown predictor.
+	*/
+	template<typename T>
+	bool Vector2Decoder<T>::readHeader()
+	{
+		if (bytes.size() - offset < Codec::HeaderSize)
+			return false;
+		uint8_t mode = bytes[offset + 8];
+		if (mode != static_cast<uint8_t>(Vector2Predictor::Delta) && mode != static_cast<uint8_t>(Vector2Predictor::Linear))
+			return false;
+		uint64_t raw = 0;
+		for (int i = 0; i < 8; i++)
+			raw |= static_cast<uint64_t>(bytes[offset + i]) << (8 * i);
+		double p;
+		std::memcpy(&p, &raw, sizeof(p));
+		precision = static_cast<T>(p);
+		predictor = static_cast<Vector2Predictor>(mode);
+		offset += Codec::HeaderSize;
+		hasHeader = true;
+		return true;
+	}
+
+	/*
+		Decode the next block into 'decoded'. Return false if it is not complete yet
+		or malformed.
+	*/
+	template<typename T>
+	bool Vector2Decoder<T>::readBlock()
+	{
+		size_t avail = bytes.size() - offset;
+		if (avail < Codec::BlockHeaderSize)
+			return false;
+		const uint8_t* h = bytes.data() + offset;
+		size_t n = static_cast<size_t>(h[0]) + 1;
+		uint32_t width[2] = { h[1], h[2] };
+		if (width[0] > 64 || width[1] > 64)
+			return false;
+		size_t size[2] = { Codec::packedSize(n, width[0]), Codec::packedSize(n, width[1]) };
+		if (avail < Codec::BlockHeaderSize + size[0] + size[1])
+			return false;
+
+		//Copied so unpacking may read past the packed bytes.
+		uint8_t packed[Codec::BlockSize * 8 + 8];
+		uint64_t residuals[2][Codec::BlockSize];
+		T quantized[Codec::BlockSize * 2];
+		const uint8_t* src = h + Codec::BlockHeaderSize;
+		for (int c = 0; c < 2; c++)
+		{
+			std::memcpy(packed, src, size[c]);
+			std::memset(packed + size[c], 0, 8);
+			Codec::unpackBits(packed, n, width[c], residuals[c]);
+			src += size[c];
+		}
+		//Undo the prediction as running sums (of the residuals for Delta, of velocity
+		//then position for Linear), both components in one loop so their dependency
+		//chains overlap. Wrapping arithmetic, as in the encoder.
+		auto rebuild = [&](auto linear)
+		{
+			uint64_t p[2] = { static_cast<uint64_t>(prev[0][0]), static_cast<uint64_t>(prev[1][0]) };
+			uint64_t v[2] = { p[0] - static_cast<uint64_t>(prev[0][1]), p[1] - static_cast<uint64_t>(prev[1][1]) };
+			for (size_t i = 0; i < n; i++)
+				for (int c = 0; c < 2; c++)
+				{
+					uint64_t r = static_cast<uint64_t>(Codec::unzigzag(residuals[c][i]));
+					if constexpr (decltype(linear)::value)
+						r = v[c] += r;
+					else
+						v[c] = r;
+					p[c] += r;
+					quantized[2 * i + c] = static_cast<T>(static_cast<int64_t>(p[c]));
+				}
+			for (int c = 0; c < 2; c++)
+			{
+				prev[c][0] = static_cast<int64_t>(p[c]);
+				prev[c][1] = static_cast<int64_t>(p[c] - v[c]);
+			}
+		};
+		if (predictor == Vector2Predictor::Linear)
+			rebuild(std::true_type());
+		else
+			rebuild(std::false_type());
+		T p = precision;
+		Simd::transform(decoded, n * 2, [p](auto a) { return a * decltype(a)::broadcast(p); }, quantized);
+		offset += Codec::BlockHeaderSize + size[0] + size[1];
+		blockCount = n;
+		blockPos = 0;
+		return true;
+	}
+
+	/*
+		Decode up to out.size() samples. Return the number of samples written; fewer
+		than requested means the remaining input is incomplete (or malformed).
+
+		@param out - destination span.
+	*/
+	template<typename T>
+	size_t Vector2Decoder<T>::decode(std::span<Vector2<T>> out)
+	{
+		if (!hasHeader && !readHeader())
+			return 0;
+
+		T* flat = VectorBatch<Vector2<T>>::flat(out);
+		size_t written = 0;
+		while (written < out.size())
+		{
+			if (blockPos == blockCount && !readBlock())
+				break;
+			size_t n = std::min(blockCount - blockPos, out.size() - written);
+			std::memcpy(flat + written * 2, decoded + blockPos * 2, n * 2 * sizeof(T));
+			blockPos += n;
+			written += n;
+		}
+		samples += written;
+		return written;
+	}
+}
@@ -0,0 +1,565 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef FORCEML_SUPPORT_IO_URING
+#include <liburing.h>
+#endif
+
+#include "TypeVector2.h"
+
+namespace Force::Math::Io
+{
+	/*
+		One asynchronous positional read or write. Backends transfer the whole range
+		(retrying short transfers) and report the byte count, or -errno, in 'result'.
+		A read stops early only at end of file.
+	*/
+	struct Request
+	{
+		int                     fd = -1;
+		std::byte*              buffer = nullptr;
+		size_t                  length = 0;
+		uint64_t                offset = 0;
+		bool                    write = false;
+
+		size_t                  transferred = 0;
+		long                    result = 0;
+		bool                    done = true;
+		std::coroutine_handle<> waiter;
+	};
+
+	/*Mark a request complete and resume the coroutine waiting on it.*/
+	inline void complete(Request* r, long result)
+	{
+		r->result = result;
+		r->done = true;
+		if (std::coroutine_handle<> h = r->waiter)
+		{
+			r->waiter = nullptr;
+			h.resume();
+		}
+	}
+
+	/*Suspend the calling coroutine until 'req' completes, then yield its result.*/
+	struct Completion
+	{
+		Request* req;
+
+		bool await_ready() const noexcept { return req->done; }
+		void await_suspend(std::coroutine_handle<> h) noexcept { req->waiter = h; }
+		long await_resume() const noexcept { return req->result; }
+	};
+
+	/*
+		Portable backend: two worker threads run pread / pwrite so one read and one
+		write can be in flight while the caller computes.
+	*/
+	class ThreadBackend
+	{
+	public:
+		ThreadBackend()
+		{
+			for (std::thread& t : workers)
+				t = std::thread([this] { work(); });
+		}
+		~ThreadBackend()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			pendingChanged.notify_all();
+			for (std::thread& t : workers)
+				t.join();
+		}
+
+		void submit(Request* r)
+		{
+			r->done = false;
+			r->transferred = 0;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pending.push_back(r);
+			}
+			pendingChanged.notify_one();
+		}
+
+		/*Block until at least one request completes and resume its waiter.*/
+		void wait()
+		{
+			std::vector<Request*> batch;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				finishedChanged.wait(lock, [this] { return !finished.empty(); });
+				batch.swap(finished);
+			}
+			for (Request* r : batch)
+				complete(r, r->result);
+		}
+
+	private:
+		void work()
+		{
+			for (;;)
+			{
+				Request* r;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					pendingChanged.wait(lock, [this] { return stopping || !pending.empty(); });
+					if (pending.empty())
+						return;
+					r = pending.front();
+					pending.pop_front();
+				}
+
+				long result = 0;
+				while (r->transferred < r->length)
+				{
+					std::byte* p = r->buffer + r->transferred;
+					size_t n = r->length - r->transferred;
+					off_t at = static_cast<off_t>(r->offset + r->transferred);
+					ssize_t k = r->write ? ::pwrite(r->fd, p, n, at) : ::pread(r->fd, p, n, at);
+					if (k < 0 && errno == EINTR)
+						continue;
+					if (k < 0)
+					{
+						result = -errno;
+						break;
+					}
+					if (k == 0)
+						break;
+					r->transferred += static_cast<size_t>(k);
+				}
+				if (result == 0)
+					result = static_cast<long>(r->transferred);
+
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					r->result = result;
+					finished.push_back(r);
+				}
+				finishedChanged.notify_one();
+			}
+		}
+
+		std::mutex              mutex;
+		std::condition_variable pendingChanged, finishedChanged;
+		std::deque<Request*>    pending;
+		std::vector<Request*>   finished;
+		bool                    stopping = false;
+		std::thread             workers[2];
+	};
+
+#ifdef FORCEML_SUPPORT_IO_URING
+	/*
+		io_uring backend: requests go straight to the kernel submission queue and
+		completions are reaped on the calling thread, with no worker threads.
+	*/
+	class UringBackend
+	{
+	public:
+		/*Largest transfer handed to one read or write; longer ranges continue as short transfers.*/
+		static constexpr size_t MaxTransfer = size_t(1) << 30;
+
+		~UringBackend()
+		{
+			if (ready)
+				io_uring_queue_exit(&ring);
+		}
+
+		/*Return false when the kernel does not provide io_uring.*/
+		bool init(unsigned depth = 16)
+		{
+			ready = io_uring_queue_init(depth, &ring, 0) == 0;
+			return ready;
+		}
+
+		void submit(Request* r)
+		{
+			r->done = false;
+			r->transferred = 0;
+			inFlight.push_back(r);
+			push(r);
+		}
+
+		/*
+			Block until at least one request completes and resume its waiter. If the
+			ring itself fails, every outstanding request completes with the error so
+			the caller stops waiting; see abort().
+		*/
+		void wait()
+		{
+			io_uring_cqe* cqe;
+			int e = waitCqe(&cqe);
+			if (e < 0)
+			{
+				abort(e);
+				return;
+			}
+			do
+			{
+				Request* r = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+				int res = cqe->res;
+				io_uring_cqe_seen(&ring, cqe);
+				if (!r)
+					continue;
+
+				if (res > 0 && r->transferred + static_cast<size_t>(res) < r->length)
+				{
+					//Short transfer: continue with the rest of the range.
+					r->transferred += static_cast<size_t>(res);
+					push(r);
+					continue;
+				}
+				if (res > 0)
+					r->transferred += static_cast<size_t>(res);
+				finish(r, res < 0 ? res : static_cast<long>(r->transferred));
+			} while (io_uring_peek_cqe(&ring, &cqe) == 0);
+		}
+
+	private:
+		int waitCqe(io_uring_cqe** cqe)
+		{
+			int e;
+			while ((e = io_uring_wait_cqe(&ring, cqe)) == -EINTR || e == -EAGAIN) {}
+			return e;
+		}
+
+		io_uring_sqe* getSqe()
+		{
+			io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+			if (!sqe)
+			{
+				io_uring_submit(&ring);
+				sqe = io_uring_get_sqe(&ring);
+			}
+			return sqe;
+		}
+
+		/*
+			Fail every outstanding request with 'error' after the ring broke. The kernel
+			owns their buffers until it posts their completions, and resuming a waiter
+			may free them, so the requests are cancelled and their completions reaped
+			first. If even that fails the ring is torn down, which cancels what is left.
+			The ring is not used again: later submissions fail with the same error.
+		*/
+		void abort(int error)
+		{
+			failure = error;
+			for (Request* r : inFlight)
+				if (io_uring_sqe* sqe = getSqe())
+				{
+					io_uring_prep_cancel(sqe, r, 0);
+					io_uring_sqe_set_data(sqe, nullptr);
+				}
+			io_uring_submit(&ring);
+
+			std::vector<Request*> owned = inFlight;
+			while (!owned.empty())
+			{
+				io_uring_cqe* cqe;
+				if (waitCqe(&cqe) < 0)
+				{
+					io_uring_queue_exit(&ring);
+					ready = false;
+					break;
+				}
+				Request* r = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+				io_uring_cqe_seen(&ring, cqe);
+				std::erase(owned, r);
+			}
+
+			std::vector<Request*> failed;
+			failed.swap(inFlight);
+			for (Request* r : failed)
+				complete(r, error);
+		}
+
+		void finish(Request* r, long result)
+		{
+			inFlight.erase(std::find(inFlight.begin(), inFlight.end(), r));
+			complete(r, result);
+		}
+
+		void push(Request* r)
+		{
+			io_uring_sqe* sqe = failure ? nullptr : getSqe();
+			if (!sqe)
+			{
+				finish(r, failure ? failure : -EBUSY);
+				return;
+			}
+			std::byte* p = r->buffer + r->transferred;
+			unsigned n = static_cast<unsigned>(std::min(r->length - r->transferred, MaxTransfer));
+			uint64_t at = r->offset + r->transferred;
+			if (r->write)
+				io_uring_prep_write(sqe, r->fd, p, n, at);
+			else
+				io_uring_prep_read(sqe, r->fd, p, n, at);
+			io_uring_sqe_set_data(sqe, r);
+			io_uring_submit(&ring);
+		}
+
+		io_uring              ring{};
+		bool                  ready = false;
+		int                   failure = 0;
+		std::vector<Request*> inFlight;
+	};
+#endif
+
+	/*Coroutine type driving a pipeline run. Starts suspended; resumed by the driver.*/
+	struct Task
+	{
+		struct promise_type
+		{
+			std::exception_ptr failure;
+
+			Task                get_return_object() { return Task{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void                return_void() {}
+			void                unhandled_exception() { failure = std::current_exception(); }
+		};
+
+		explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+		Task(Task&& o) noexcept : handle(o.handle) { o.handle = nullptr; }
+		Task(const Task&) = delete;
+		~Task()
+		{
+			if (handle)
+				handle.destroy();
+		}
+
+		/*Run the coroutine to completion, reaping I/O on this thread.*/
+		template<typename Backend>
+		void drive(Backend& backend)
+		{
+			handle.resume();
+			while (!handle.done())
+				backend.wait();
+			if (handle.promise().failure)
+				std::rethrow_exception(handle.promise().failure);
+		}
+
+		std::coroutine_handle<promise_type> handle;
+	};
+}
+
+namespace Force::Math
+{
+	/*
+		Streams a file of raw Vector2<T> samples through a chain of batch stages into
+		another file, one fixed-size chunk at a time. Memory use is three chunks no
+		matter how large the input is.
+
+		Three buffers rotate so that reading chunk i + 1, running the stages on chunk i
+		and writing chunk i - 1 all overlap. The I/O goes through io_uring when built
+		with FORCEML_SUPPORT_IO_URING and supported by the kernel, and through worker
+		threads otherwise. POSIX only.
+
+		A stage receives a chunk, may modify it in place, and returns how many leading
+		elements to keep, so stages can filter as well as transform:
+
+			pipeline.then([](std::span<Vector2<float>> c) { VectorBatch<Vector2<float>>::normalize(c, c); return c.size(); });
+	*/
+	template<typename T>
+	class Vector2Pipeline
+	{
+	public:
+		using Stage = std::function<size_t(std::span<Vector2<T>>)>;
+
+		/*Outcome of a run. 'error' is an errno value when ok is false.*/
+		struct Result
+		{
+			bool     ok = true;
+			int      error = 0;
+			uint64_t read = 0;
+			uint64_t written = 0;
+		};
+
+		explicit Vector2Pipeline(size_t chunkSize = 1 << 16) : chunkSize(chunkSize) {}
+
+		Vector2Pipeline<T>& then(Stage stage);
+		Result              run(const char* inputPath, const char* outputPath);
+
+	private:
+		static constexpr uint32_t Slots = 3;
+
+		template<typename Backend>
+		Io::Task process(Backend& backend, int in, int out, Result& result);
+
+		size_t             chunkSize;
+		std::vector<Stage> stages;
+	};
+
+	/*
+		Append a stage to the chain. Stages run in the order they were added.
+	*/
+	template<typename T>
+	inline Vector2Pipeline<T>& Vector2Pipeline<T>::then(Stage stage)
+	{
+		stages.push_back(std::move(stage));
+		return *this;
+	}
+
+	/*
+		Stream 'inputPath' through the stages into 'outputPath', which is created or
+		truncated. A trailing partial element in the input is ignored.
+
+		@param inputPath - file of raw Vector2<T> samples.
+		@param outputPath - destination file.
+	*/
+	template<typename T>
+	typename Vector2Pipeline<T>::Result Vector2Pipeline<T>::run(const char* inputPath, const char* outputPath)
+	{
+		Result result;
+		int in = ::open(inputPath, O_RDONLY);
+		if (in < 0)
+			return { false, errno, 0, 0 };
+		int out = ::open(outputPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (out < 0)
+		{
+			int e = errno;
+			::close(in);
+			return { false, e, 0, 0 };
+		}
+
+		try
+		{
+#ifdef FORCEML_SUPPORT_IO_URING
+			Io::UringBackend uring;
+			if (uring.init())
+				process(uring, in, out, result).drive(uring);
+			else
+#endif
+			{
+				Io::ThreadBackend threads;
+				process(threads, in, out, result).drive(threads);
+			}
+		}
+		catch (...)
+		{
+			//A stage threw; all I/O has drained, release the files and pass it on.
+			::close(in);
+			::close(out);
+			throw;
+		}
+
+		::close(in);
+		if (::close(out) != 0 && result.ok)
+			result = { false, errno, result.read, result.written };
+		return result;
+	}
+
+	template<typename T>
+	template<typename Backend>
+	Io::Task Vector2Pipeline<T>::process(Backend& backend, int in, int out, Result& result)
+	{
+		const size_t chunkBytes = chunkSize * sizeof(Vector2<T>);
+		std::vector<Vector2<T>> buffers[Slots];
+		Io::Request reads[Slots], writes[Slots];
+		for (uint32_t s = 0; s < Slots; s++)
+			buffers[s].resize(chunkSize);
+
+		uint64_t readOffset = 0, writeOffset = 0;
+		auto startRead = [&](uint32_t s) {
+			reads[s].fd = in;
+			reads[s].buffer = reinterpret_cast<std::byte*>(buffers[s].data());
+			reads[s].length = chunkBytes;
+			reads[s].offset = readOffset;
+			reads[s].write = false;
+			readOffset += chunkBytes;
+			backend.submit(&reads[s]);
+		};
+		auto fail = [&](long code) {
+			if (result.ok)
+				result = { false, static_cast<int>(-code), result.read, result.written };
+		};
+
+		std::exception_ptr failure;
+		bool readPending = true;
+		startRead(0);
+		for (uint32_t i = 0;; i = (i + 1) % Slots)
+		{
+			long got = co_await Io::Completion{ &reads[i] };
+			readPending = false;
+			if (got <= 0)
+			{
+				if (got < 0)
+					fail(got);
+				break;
+			}
+
+			//Reuse the next slot for read-ahead once its earlier write has drained.
+			uint32_t next = (i + 1) % Slots;
+			long w = co_await Io::Completion{ &writes[next] };
+			if (w < 0)
+			{
+				fail(w);
+				break;
+			}
+			bool last = static_cast<size_t>(got) < chunkBytes;
+			if (!last)
+			{
+				startRead(next);
+				readPending = true;
+			}
+
+			size_t count = static_cast<size_t>(got) / sizeof(Vector2<T>);
+			result.read += count;
+			try
+			{
+				for (const Stage& stage : stages)
+					count = std::min(count, stage(std::span<Vector2<T>>(buffers[i].data(), count)));
+			}
+			catch (...)
+			{
+				failure = std::current_exception();
+				break;
+			}
+
+			if (count)
+			{
+				writes[i].fd = out;
+				writes[i].buffer = reinterpret_cast<std::byte*>(buffers[i].data());
+				writes[i].length = count * sizeof(Vector2<T>);
+				writes[i].offset = writeOffset;
+				writes[i].write = true;
+				writeOffset += writes[i].length;
+				result.written += count;
+				backend.submit(&writes[i]);
+			}
+			if (last)
+				break;
+		}
+
+		//Never leave the frame while the kernel or a worker still owns a buffer.
+		if (readPending)
+			for (uint32_t s = 0; s < Slots; s++)
+				co_await Io::Completion{ &reads[s] };
+		for (uint32_t s = 0; s < Slots; s++)
+		{
+			long w = co_await Io::Completion{ &writes[s] };
+			if (w < 0)
+				fail(w);
+		}
+		if (failure)
+			std::rethrow_exception(failure);
+	}
+}
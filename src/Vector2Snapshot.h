@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*
+		Publishes frames of Vector2<T> state from one writer thread to any number of
+		reader threads without locks or copies.
+
+		A fixed pool of 2 * maxReaders + 2 buffers is allocated up front. The writer
+		fills a buffer nobody references and publishes it with one atomic store; readers
+		pin the latest published buffer by bumping its reference count and see an
+		immutable span until they release it. A reader may pin two buffers at once, as
+		in the usual refresh 'frame = snapshot.acquire();' where the new frame is pinned
+		before the old one is released, so at most 2 * maxReaders buffers are pinned
+		and, with the published one, there is always a free buffer left: the writer
+		never waits and memory never grows past the pool. Holding more frames than that
+		makes beginWrite() fail rather than overwrite a pinned buffer.
+	*/
+	template<typename T>
+	class Vector2Snapshot
+	{
+		struct alignas(64) Slot
+		{
+			std::atomic<uint32_t>   refs{ 0 };
+			uint64_t                frame = 0;
+			size_t                  count = 0;
+			std::vector<Vector2<T>> items;
+		};
+
+	public:
+		/*
+			Read access to one published frame. Keeps the buffer alive until destroyed
+			or reset; hold it only as long as the frame is needed.
+		*/
+		class Frame
+		{
+		public:
+			Frame() = default;
+			Frame(Frame&& o) noexcept : slot(o.slot) { o.slot = nullptr; }
+			Frame& operator=(Frame&& o) noexcept;
+			Frame(const Frame&) = delete;
+			~Frame() { reset(); }
+
+			std::span<const Vector2<T>> data() const { return { slot->items.data(), slot->count }; }
+			uint64_t                    getFrame() const { return slot->frame; }
+			explicit                    operator bool() const { return slot != nullptr; }
+			void                        reset();
+
+		private:
+			friend class Vector2Snapshot;
+			explicit Frame(Slot* s) : slot(s) {}
+
+			Slot* slot = nullptr;
+		};
+
+		explicit Vector2Snapshot(size_t maxReaders, size_t capacity = 0);
+
+		Frame                 acquire() const;
+		std::span<Vector2<T>> beginWrite(size_t count);
+		uint64_t              publish();
+		uint64_t              getFrame() const { return frames.load(); }
+
+	private:
+		std::unique_ptr<Slot[]> slots;
+		uint32_t                slotCount;
+		uint32_t                back = 0;
+		bool                    writing = false;
+
+		alignas(64) mutable std::atomic<uint32_t> published{ 1 };
+		std::atomic<uint64_t>                     frames{ 0 };
+	};
+
+	/*
+		@param maxReaders - number of reader threads, each holding at most one frame
+		outside of a refresh.
+		@param capacity - elements to reserve in every buffer, so that steady-state
+		frames do not allocate.
+	*/
+	template<typename T>
+	Vector2Snapshot<T>::Vector2Snapshot(size_t maxReaders, size_t capacity)
+		: slots(new Slot[2 * maxReaders + 2]), slotCount(static_cast<uint32_t>(2 * maxReaders + 2))
+	{
+		for (uint32_t i = 0; i < slotCount; i++)
+			slots[i].items.reserve(capacity);
+	}
+
+	/*
+		Pin the latest published frame. Frame 0 is empty. Lock-free: retries only
+		while the writer publishes concurrently.
+	*/
+	template<typename T>
+	typename Vector2Snapshot<T>::Frame Vector2Snapshot<T>::acquire() const
+	{
+		for (;;)
+		{
+			uint32_t i = published.load();
+			slots[i].refs.fetch_add(1);
+			//The buffer is only safe if it is still the published one after pinning;
+			//otherwise the writer may already be refilling it.
+			if (published.load() == i)
+				return Frame(&slots[i]);
+			slots[i].refs.fetch_sub(1);
+		}
+	}
+
+	/*
+		Start a frame and return its buffer, sized to 'count'. The contents are those
+		of an older frame; the writer is expected to overwrite what it needs. Only one
+		thread may write. Return an empty span, and start no frame, if every buffer is
+		pinned because readers hold more frames than the pool was sized for.
+
+		@param count - number of elements of the new frame.
+	*/
+	template<typename T>
+	std::span<Vector2<T>> Vector2Snapshot<T>::beginWrite(size_t count)
+	{
+		assert(!writing);
+		uint32_t current = published.load();
+		back = slotCount;
+		for (uint32_t i = 0; i < slotCount; i++)
+			if (i != current && slots[i].refs.load() == 0)
+			{
+				back = i;
+				break;
+			}
+		if (back == slotCount)
+			return {};
+
+		Slot& s = slots[back];
+		if (s.items.size() < count)
+			s.items.resize(count);
+		s.count = count;
+		writing = true;
+		return { s.items.data(), count };
+	}
+
+	/*
+		Publish the frame started by beginWrite(). Readers acquiring after this call
+		see it; snapshots already held keep their frame. Return the frame number, or 0
+		if beginWrite() failed. getFrame() reports the same number to any thread.
+	*/
+	template<typename T>
+	uint64_t Vector2Snapshot<T>::publish()
+	{
+		if (!writing)
+			return 0;
+		writing = false;
+		uint64_t frame = frames.load() + 1;
+		slots[back].frame = frame;
+		//Count before publishing, so getFrame() is never behind a frame a reader holds.
+		frames.store(frame);
+		published.store(back);
+		return frame;
+	}
+
+	template<typename T>
+	typename Vector2Snapshot<T>::Frame& Vector2Snapshot<T>::Frame::operator=(Frame&& o) noexcept
+	{
+		if (this != &o)
+		{
+			reset();
+			slot = o.slot;
+			o.slot = nullptr;
+		}
+		return *this;
+	}
+
+	/*
+		Release the frame early, making its buffer available to the writer again.
+	*/
+	template<typename T>
+	inline void Vector2Snapshot<T>::Frame::reset()
+	{
+		if (slot)
+			slot->refs.fetch_sub(1);
+		slot = nullptr;
+	}
+}
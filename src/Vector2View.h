@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "TypeVector2.h"
+
+namespace Force::Math
+{
+	/*
+		True when an array of U can be read as an array of Vector2<T> in place: same
+		size, compatible alignment, and a plain layout with no hidden state. Holds for
+		glm::vec2, T[2] and any { T x, y; } struct.
+	*/
+	template<typename U, typename T>
+	inline constexpr bool IsVector2Layout =
+		std::is_standard_layout_v<std::remove_cv_t<U>> &&
+		std::is_trivially_copyable_v<std::remove_cv_t<U>> &&
+		sizeof(U) == sizeof(Vector2<T>) &&
+		alignof(U) % alignof(Vector2<T>) == 0;
+
+	static_assert(sizeof(Vector2<float>) == 2 * sizeof(float) && std::is_standard_layout_v<Vector2<float>>);
+	static_assert(sizeof(Vector2<double>) == 2 * sizeof(double) && std::is_standard_layout_v<Vector2<double>>);
+#ifdef FORCEML_SUPPORT_GLM
+	static_assert(IsVector2Layout<glm::vec2, float>, "glm::vec2 must be layout compatible with Vector2<float>.");
+#endif
+
+	template<typename U, typename T>
+	using Vector2SpanOf = std::span<std::conditional_t<std::is_const_v<U>, const Vector2<T>, Vector2<T>>>;
+
+	/*
+		View a span of U as two-dimensional vectors without copying. U is either a
+		layout-compatible pair type (glm::vec2, float[2]...), or T itself, in which
+		case consecutive components are paired and the size must be even.
+
+		@param s - the data to view; the view aliases it.
+	*/
+	template<typename T, typename U, size_t E>
+	inline Vector2SpanOf<U, T> asVector2(std::span<U, E> s)
+	{
+		using V = typename Vector2SpanOf<U, T>::element_type;
+		if constexpr (std::is_same_v<std::remove_cv_t<U>, T>)
+		{
+			assert(s.size() % 2 == 0);
+			return { reinterpret_cast<V*>(s.data()), s.size() / 2 };
+		}
+		else
+		{
+			static_assert(IsVector2Layout<U, T>, "Element type is not layout compatible with Vector2<T>.");
+			return { reinterpret_cast<V*>(s.data()), s.size() };
+		}
+	}
+
+	/*
+		View a span of two-dimensional vectors as a layout-compatible type, e.g.
+		glm::vec2 when handing data back to another library, or T for the flat
+		component array.
+
+		@param s - the vectors to view; the view aliases them.
+	*/
+	template<typename U, typename T>
+	inline auto asLayout(std::span<Vector2<T>> s)
+	{
+		if constexpr (std::is_same_v<U, T>)
+			return std::span<T>(VectorBatch<Vector2<T>>::flat(s), s.size() * 2);
+		else
+		{
+			static_assert(IsVector2Layout<U, T>, "Target type is not layout compatible with Vector2<T>.");
+			return std::span<U>(reinterpret_cast<U*>(s.data()), s.size());
+		}
+	}
+
+	/*
+		Read-only form of asLayout(), for vectors that must not be written through the
+		view. U is given without const; the view's elements are const.
+	*/
+	template<typename U, typename T>
+	inline auto asLayout(std::span<const Vector2<T>> s)
+	{
+		if constexpr (std::is_same_v<U, T>)
+			return std::span<const T>(VectorBatch<Vector2<T>>::flat(s), s.size() * 2);
+		else
+		{
+			static_assert(IsVector2Layout<U, T>, "Target type is not layout compatible with Vector2<T>.");
+			return std::span<const U>(reinterpret_cast<const U*>(s.data()), s.size());
+		}
+	}
+
+	/*Component type of a range of Vector2<T>.*/
+	template<typename R>
+	using Vector2RangeValue = typename std::ranges::range_value_t<R>::ValueType;
+
+	/*
+		View of two-dimensional vectors inside an interleaved buffer, such as a GPU
+		vertex buffer where each vertex holds a position followed by other attributes.
+		Elements are accessed in place.
+	*/
+	template<typename T>
+	class Vector2StridedView
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = Vector2<T>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = Vector2<T>*;
+			using reference = Vector2<T>&;
+
+			Iterator() = default;
+			Iterator(std::byte* p, size_t stride) : p(p), stride(stride) {}
+
+			reference  operator*() const { return *reinterpret_cast<pointer>(p); }
+			pointer    operator->() const { return reinterpret_cast<pointer>(p); }
+			reference  operator[](difference_type n) const { return *(*this + n); }
+			Iterator&  operator++() { p += stride; return *this; }
+			Iterator   operator++(int) { Iterator r = *this; p += stride; return r; }
+			Iterator&  operator--() { p -= stride; return *this; }
+			Iterator   operator--(int) { Iterator r = *this; p -= stride; return r; }
+			Iterator&  operator+=(difference_type n) { p += n * static_cast<difference_type>(stride); return *this; }
+			Iterator&  operator-=(difference_type n) { p -= n * static_cast<difference_type>(stride); return *this; }
+			friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+			friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+			friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+			friend difference_type operator-(const Iterator& a, const Iterator& b) { return (a.p - b.p) / static_cast<difference_type>(a.stride); }
+			friend bool operator==(const Iterator& a, const Iterator& b) { return a.p == b.p; }
+			friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.p <=> b.p; }
+
+		private:
+			std::byte* p = nullptr;
+			size_t     stride = 0;
+		};
+
+		Vector2StridedView() = default;
+		Vector2StridedView(void* buffer, size_t count, size_t stride, size_t offset = 0);
+
+		Vector2<T>&           operator[](size_t i) const;
+		size_t                size() const { return count; }
+		size_t                getStride() const { return stride; }
+		bool                  isContiguous() const { return stride == sizeof(Vector2<T>); }
+		std::span<Vector2<T>> contiguous() const;
+		Iterator              begin() const { return Iterator(base, stride); }
+		Iterator              end() const { return Iterator(base + count * stride, stride); }
+
+	private:
+		std::byte* base = nullptr;
+		size_t     count = 0;
+		size_t     stride = 0;
+	};
+
+	/*
+		Create a view over 'count' vectors in 'buffer'.
+
+		@param buffer - start of the interleaved buffer.
+		@param count - number of elements.
+		@param stride - distance in bytes between consecutive elements.
+		@param offset - byte offset of the vector inside each element.
+	*/
+	template<typename T>
+	inline Vector2StridedView<T>::Vector2StridedView(void* buffer, size_t count, size_t stride, size_t offset)
+		: base(static_cast<std::byte*>(buffer) + offset), count(count), stride(stride)
+	{
+		assert(stride >= sizeof(Vector2<T>));
+		assert(reinterpret_cast<uintptr_t>(base) % alignof(Vector2<T>) == 0 && stride % alignof(Vector2<T>) == 0);
+	}
+
+	/*
+		Return the vector of element i.
+	*/
+	template<typename T>
+	inline Vector2<T>& Vector2StridedView<T>::operator[](size_t i) const
+	{
+		assert(i < count);
+		return *reinterpret_cast<Vector2<T>*>(base + i * stride);
+	}
+
+	/*
+		Return the view as a plain span. Only valid when the buffer holds nothing but
+		vectors (see isContiguous()).
+	*/
+	template<typename T>
+	inline std::span<Vector2<T>> Vector2StridedView<T>::contiguous() const
+	{
+		assert(isContiguous());
+		return { reinterpret_cast<Vector2<T>*>(base), count };
+	}
+
+	/*
+		Split an array of vectors into separate x and y arrays. Takes spans or any
+		other contiguous ranges; the component type is deduced from 'in'.
+
+		@param in - vectors to read.
+		@param outX, outY - receive the components, same size as 'in'.
+	*/
+	template<std::ranges::contiguous_range In, std::ranges::contiguous_range Xs, std::ranges::contiguous_range Ys>
+	void aosToSoa(In&& inRange, Xs&& outX, Ys&& outY)
+	{
+		using T = Vector2RangeValue<In>;
+		std::span<const Vector2<T>> in(inRange);
+		std::span<T> xs(outX), ys(outY);
+		assert(xs.size() == in.size() && ys.size() == in.size());
+		using P = Simd::Pack<T>;
+		const T* src = VectorBatch<Vector2<T>>::flat(in);
+		size_t n = in.size(), i = 0;
+		for (; i + P::Width <= n; i += P::Width)
+		{
+			P even, odd;
+			Simd::deinterleave(P::load(src + 2 * i), P::load(src + 2 * i + P::Width), even, odd);
+			even.store(xs.data() + i);
+			odd.store(ys.data() + i);
+		}
+		for (; i < n; i++)
+		{
+			xs[i] = in[i].x;
+			ys[i] = in[i].y;
+		}
+	}
+
+	/*
+		Merge separate x and y arrays into an array of vectors. Takes spans or any
+		other contiguous ranges; the component type is deduced from 'out'.
+
+		@param inX, inY - components to read.
+		@param outRange - receives the vectors, same size as the component arrays.
+	*/
+	template<std::ranges::contiguous_range Xs, std::ranges::contiguous_range Ys, std::ranges::contiguous_range Out>
+	void soaToAos(Xs&& inX, Ys&& inY, Out&& outRange)
+	{
+		using T = Vector2RangeValue<Out>;
+		std::span<const T> xs(inX), ys(inY);
+		std::span<Vector2<T>> out(outRange);
+		assert(xs.size() == out.size() && ys.size() == out.size());
+		using P = Simd::Pack<T>;
+		T* dst = VectorBatch<Vector2<T>>::flat(out);
+		size_t n = out.size(), i = 0;
+		for (; i + P::Width <= n; i += P::Width)
+		{
+			P a, b;
+			Simd::interleave(P::load(xs.data() + i), P::load(ys.data() + i), a, b);
+			a.store(dst + 2 * i);
+			b.store(dst + 2 * i + P::Width);
+		}
+		for (; i < n; i++)
+			out[i].set(xs[i], ys[i]);
+	}
+
+	/*
+		Gather the vectors of an interleaved buffer into separate x and y arrays.
+		Falls back to the contiguous kernel when the buffer holds only vectors.
+	*/
+	template<typename T, typename Xs, typename Ys>
+	void aosToSoa(const Vector2StridedView<T>& in, Xs&& outX, Ys&& outY)
+	{
+		std::span<T> xs(outX), ys(outY);
+		if (in.isContiguous())
+			return aosToSoa(in.contiguous(), xs, ys);
+		assert(xs.size() == in.size() && ys.size() == in.size());
+		for (size_t i = 0; i < in.size(); i++)
+		{
+			xs[i] = in[i].x;
+			ys[i] = in[i].y;
+		}
+	}
+
+	/*
+		Scatter separate x and y arrays into the vectors of an interleaved buffer,
+		leaving the other attributes untouched.
+	*/
+	template<typename T, typename Xs, typename Ys>
+	void soaToAos(Xs&& inX, Ys&& inY, const Vector2StridedView<T>& out)
+	{
+		std::span<const T> xs(inX), ys(inY);
+		if (out.isContiguous())
+			return soaToAos(xs, ys, out.contiguous());
+		assert(xs.size() == out.size() && ys.size() == out.size());
+		for (size_t i = 0; i < out.size(); i++)
+			out[i].set(xs[i], ys[i]);
+	}
+}